@@ -2682,6 +2682,11 @@ MaybeLocal<UnboundScript> ScriptCompiler::CompileUnboundInternal(
       i_isolate, source->resource_name, source->resource_line_offset,
       source->resource_column_offset, source->source_map_url,
       source->host_defined_options, source->resource_options);
+  if (options == kConsumeCompileHints) {
+    script_details.compile_hint_callback = source->compile_hint_callback;
+    script_details.compile_hint_callback_data =
+        source->compile_hint_callback_data;
+  }
 
   i::MaybeHandle<i::SharedFunctionInfo> maybe_function_info;
   if (options == kConsumeCodeCache) {
@@ -2750,7 +2755,7 @@ MaybeLocal<Module> ScriptCompiler::CompileModule(
     NoCacheReason no_cache_reason) {
   Utils::ApiCheck(
       options == kNoCompileOptions || options == kConsumeCodeCache ||
-          options == kProduceCompileHints,
+          options == kProduceCompileHints || options == kConsumeCompileHints,
       "v8::ScriptCompiler::CompileModule", "Invalid CompileOptions");
   Utils::ApiCheck(source->GetResourceOptions().IsModule(),
                   "v8::ScriptCompiler::CompileModule",
@@ -2885,17 +2890,20 @@ void ScriptCompiler::ScriptStreamingTask::Run() { data_->task->Run(); }
 
 ScriptCompiler::ScriptStreamingTask* ScriptCompiler::StartStreaming(
     Isolate* v8_isolate, StreamedSource* source, v8::ScriptType type,
-    CompileOptions options) {
+    CompileOptions options, CompileHintCallback compile_hint_callback,
+    void* compile_hint_callback_data) {
   Utils::ApiCheck(options == kNoCompileOptions || options == kEagerCompile ||
-                      options == kProduceCompileHints,
+                      options == kProduceCompileHints ||
+                      options == kConsumeCompileHints,
                   "v8::ScriptCompiler::StartStreaming",
                   "Invalid CompileOptions");
   if (!i::v8_flags.script_streaming) return nullptr;
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
   i::ScriptStreamingData* data = source->impl();
   std::unique_ptr<i::BackgroundCompileTask> task =
-      std::make_unique<i::BackgroundCompileTask>(data, i_isolate, type,
-                                                 options);
+      std::make_unique<i::BackgroundCompileTask>(
+          data, i_isolate, type, options, compile_hint_callback,
+          compile_hint_callback_data);
   data->task = std::move(task);
   return new ScriptCompiler::ScriptStreamingTask(data);
 }
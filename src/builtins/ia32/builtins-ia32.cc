@@ -861,8 +861,15 @@ static void AdvanceBytecodeOffsetOrReturn(MacroAssembler* masm,
 namespace {
 
 void ResetBytecodeAge(MacroAssembler* masm, Register bytecode_array) {
+  // Only write the age if it changes. Bytecode in the shared heap is never
+  // aged, so it is never written to here.
+  Label done;
+  __ cmpw(FieldOperand(bytecode_array, BytecodeArray::kBytecodeAgeOffset),
+          Immediate(0));
+  __ j(equal, &done, Label::kNear);
   __ mov_w(FieldOperand(bytecode_array, BytecodeArray::kBytecodeAgeOffset),
            Immediate(0));
+  __ bind(&done);
 }
 
 void ResetFeedbackVectorOsrUrgency(MacroAssembler* masm,
@@ -4,6 +4,9 @@
 
 #include "src/codegen/compilation-cache.h"
 
+#include "src/base/functional.h"
+#include "src/base/lazy-instance.h"
+#include "src/codegen/script-details.h"
 #include "src/common/globals.h"
 #include "src/heap/factory.h"
 #include "src/logging/counters.h"
@@ -13,6 +16,7 @@
 #include "src/objects/objects.h"
 #include "src/objects/slots.h"
 #include "src/objects/visitors.h"
+#include "src/snapshot/code-serializer.h"
 #include "src/utils/ostreams.h"
 
 namespace v8 {
@@ -270,6 +274,107 @@ void CompilationCache::Remove(Handle<SharedFunctionInfo> function_info) {
   script_.Remove(function_info);
 }
 
+namespace {
+
+base::Vector<const uint8_t> SourceBytes(String source,
+                                        const DisallowGarbageCollection& no_gc,
+                                        bool* is_one_byte) {
+  String::FlatContent content = source.GetFlatContent(no_gc);
+  DCHECK(content.IsFlat());
+  *is_one_byte = content.IsOneByte();
+  if (content.IsOneByte()) return content.ToOneByteVector();
+  base::Vector<const base::uc16> chars = content.ToUC16Vector();
+  return base::Vector<const uint8_t>(
+      reinterpret_cast<const uint8_t*>(chars.begin()),
+      chars.length() * sizeof(base::uc16));
+}
+
+}  // namespace
+
+DEFINE_LAZY_LEAKY_OBJECT_GETTER(ProcessWideCompilationCache,
+                                GetProcessWideCompilationCache)
+
+// static
+ProcessWideCompilationCache* ProcessWideCompilationCache::Get() {
+  return GetProcessWideCompilationCache();
+}
+
+std::unordered_multimap<size_t, ProcessWideCompilationCache::Entry>::iterator
+ProcessWideCompilationCache::Find(size_t hash, Handle<String> source,
+                                  ScriptOriginOptions origin_options) {
+  DisallowGarbageCollection no_gc;
+  bool is_one_byte;
+  base::Vector<const uint8_t> bytes = SourceBytes(*source, no_gc, &is_one_byte);
+  auto range = entries_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const Entry& entry = it->second;
+    if (entry.origin_flags == origin_options.Flags() &&
+        entry.is_one_byte == is_one_byte &&
+        entry.source.size() == bytes.size() &&
+        std::equal(bytes.begin(), bytes.end(), entry.source.begin())) {
+      return it;
+    }
+  }
+  return entries_.end();
+}
+
+ProcessWideCompilationCache::Data ProcessWideCompilationCache::Lookup(
+    Handle<String> source, ScriptOriginOptions origin_options) {
+  size_t hash;
+  {
+    DisallowGarbageCollection no_gc;
+    bool is_one_byte;
+    base::Vector<const uint8_t> bytes =
+        SourceBytes(*source, no_gc, &is_one_byte);
+    hash = base::hash_range(bytes.begin(), bytes.end());
+  }
+  base::MutexGuard guard(&mutex_);
+  auto it = Find(hash, source, origin_options);
+  if (it == entries_.end()) return nullptr;
+  return it->second.data;
+}
+
+void ProcessWideCompilationCache::Put(Handle<String> source,
+                                      ScriptOriginOptions origin_options,
+                                      std::vector<uint8_t> data) {
+  DisallowGarbageCollection no_gc;
+  bool is_one_byte;
+  base::Vector<const uint8_t> bytes = SourceBytes(*source, no_gc, &is_one_byte);
+  size_t hash = base::hash_range(bytes.begin(), bytes.end());
+
+  base::MutexGuard guard(&mutex_);
+  auto it = Find(hash, source, origin_options);
+  if (it != entries_.end()) {
+    // The previous data was rejected by the Isolate which compiled the script
+    // again, e.g. because of a flag change.
+    size_ -= it->second.data->size();
+    size_ += data.size();
+    it->second.data =
+        std::make_shared<const std::vector<uint8_t>>(std::move(data));
+    return;
+  }
+
+  size_t entry_size = bytes.size() + data.size();
+  if (size_ + entry_size > MaxSize()) return;
+  size_ += entry_size;
+  entries_.emplace(
+      hash,
+      Entry{origin_options.Flags(), is_one_byte,
+            std::vector<uint8_t>(bytes.begin(), bytes.end()),
+            std::make_shared<const std::vector<uint8_t>>(std::move(data))});
+}
+
+bool ProcessWideCompilationCache::IsFull() {
+  base::MutexGuard guard(&mutex_);
+  return size_ >= MaxSize();
+}
+
+void ProcessWideCompilationCache::Clear() {
+  base::MutexGuard guard(&mutex_);
+  entries_.clear();
+  size_ = 0;
+}
+
 CompilationCacheScript::LookupResult CompilationCache::LookupScript(
     Handle<String> source, const ScriptDetails& script_details,
     LanguageMode language_mode) {
@@ -277,6 +382,21 @@ CompilationCacheScript::LookupResult CompilationCache::LookupScript(
   return script_.Lookup(source, script_details);
 }
 
+ProcessWideCompilationCache::Data
+CompilationCache::LookupScriptInProcessWideCache(
+    Handle<String> source, const ScriptDetails& script_details,
+    LanguageMode language_mode) {
+  if (!IsEnabledProcessWideScript(language_mode)) return nullptr;
+  source = String::Flatten(isolate(), source);
+  ProcessWideCompilationCache::Data data =
+      ProcessWideCompilationCache::Get()->Lookup(source,
+                                                 script_details.origin_options);
+  if (data) {
+    isolate()->counters()->compilation_cache_process_wide_hits()->Increment();
+  }
+  return data;
+}
+
 InfoCellPair CompilationCache::LookupEval(Handle<String> source,
                                           Handle<SharedFunctionInfo> outer_info,
                                           Handle<Context> context,
@@ -321,6 +441,24 @@ void CompilationCache::PutScript(Handle<String> source,
   script_.Put(source, function_info);
 }
 
+void CompilationCache::PutScriptInProcessWideCache(
+    Handle<String> source, LanguageMode language_mode,
+    Handle<SharedFunctionInfo> function_info) {
+  if (!IsEnabledProcessWideScript(language_mode)) return;
+  // Don't bother serializing if the result can't be stored anyway.
+  if (ProcessWideCompilationCache::Get()->IsFull()) return;
+  std::unique_ptr<ScriptCompiler::CachedData> cached_data(
+      CodeSerializer::Serialize(function_info));
+  // Scripts containing asm.js modules can't be serialized.
+  if (!cached_data) return;
+  Script script = Script::cast(function_info->script());
+  source = String::Flatten(isolate(), source);
+  ProcessWideCompilationCache::Get()->Put(
+      source, script.origin_options(),
+      std::vector<uint8_t>(cached_data->data,
+                           cached_data->data + cached_data->length));
+}
+
 void CompilationCache::PutEval(Handle<String> source,
                                Handle<SharedFunctionInfo> outer_info,
                                Handle<Context> context,
@@ -5,7 +5,12 @@
 #ifndef V8_CODEGEN_COMPILATION_CACHE_H_
 #define V8_CODEGEN_COMPILATION_CACHE_H_
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "src/base/hashmap.h"
+#include "src/base/platform/mutex.h"
 #include "src/objects/compilation-cache-table.h"
 #include "src/utils/allocation.h"
 
@@ -135,6 +140,55 @@ class CompilationCacheRegExp {
   DISALLOW_IMPLICIT_CONSTRUCTORS(CompilationCacheRegExp);
 };
 
+// Process-wide cache of compiled scripts, shared by all Isolates of the process
+// (--process-wide-compilation-cache). Heap objects can't be shared between
+// Isolates, so entries hold a code cache produced by the CodeSerializer, from
+// which each Isolate materializes its own Script and SharedFunctionInfos
+// instead of parsing and compiling the same source again. Entries are keyed by
+// the content of the source string and the origin options. They are never
+// evicted; the cache just stops growing once it reaches
+// --process-wide-compilation-cache-size.
+class V8_EXPORT_PRIVATE ProcessWideCompilationCache final {
+ public:
+  using Data = std::shared_ptr<const std::vector<uint8_t>>;
+
+  static ProcessWideCompilationCache* Get();
+
+  // Returns the serialized code for {source}, or null. {source} must be flat.
+  Data Lookup(Handle<String> source, ScriptOriginOptions origin_options);
+
+  // Associates serialized code with {source}, replacing any existing entry.
+  // {source} must be flat.
+  void Put(Handle<String> source, ScriptOriginOptions origin_options,
+           std::vector<uint8_t> data);
+
+  bool IsFull();
+
+  // Drops all entries. Only used in tests.
+  void Clear();
+
+ private:
+  static size_t MaxSize() {
+    return static_cast<size_t>(v8_flags.process_wide_compilation_cache_size) *
+           MB;
+  }
+
+  struct Entry {
+    int origin_flags;
+    bool is_one_byte;
+    std::vector<uint8_t> source;
+    Data data;
+  };
+
+  // Returns the entry with the same source and origin options, or end().
+  std::unordered_multimap<size_t, Entry>::iterator Find(
+      size_t hash, Handle<String> source, ScriptOriginOptions origin_options);
+
+  base::Mutex mutex_;
+  std::unordered_multimap<size_t, Entry> entries_;
+  size_t size_ = 0;
+};
+
 // The compilation cache keeps shared function infos for compiled
 // scripts and evals. The shared function infos are looked up using
 // the source string as the key. For regular expressions the
@@ -151,6 +205,13 @@ class V8_EXPORT_PRIVATE CompilationCache {
       Handle<String> source, const ScriptDetails& script_details,
       LanguageMode language_mode);
 
+  // Finds serialized code for a script source string in the process-wide
+  // compilation cache, possibly put there by another Isolate. Returns null if
+  // there is none.
+  ProcessWideCompilationCache::Data LookupScriptInProcessWideCache(
+      Handle<String> source, const ScriptDetails& script_details,
+      LanguageMode language_mode);
+
   // Finds the shared function info for a source string for eval in a
   // given context.  Returns an empty handle if the cache doesn't
   // contain a script for the given source string.
@@ -169,6 +230,12 @@ class V8_EXPORT_PRIVATE CompilationCache {
   void PutScript(Handle<String> source, LanguageMode language_mode,
                  Handle<SharedFunctionInfo> function_info);
 
+  // Serializes the compiled script into the process-wide compilation cache, so
+  // that other Isolates compiling the same source can reuse it.
+  void PutScriptInProcessWideCache(Handle<String> source,
+                                   LanguageMode language_mode,
+                                   Handle<SharedFunctionInfo> function_info);
+
   // Associate the (source, context->closure()->shared(), kind) triple
   // with the shared function info. This may overwrite an existing mapping.
   void PutEval(Handle<String> source, Handle<SharedFunctionInfo> outer_info,
@@ -219,6 +286,10 @@ class V8_EXPORT_PRIVATE CompilationCache {
     // only contains scripts which were compiled with the default language mode.
     return IsEnabledScriptAndEval() && language_mode == LanguageMode::kSloppy;
   }
+  bool IsEnabledProcessWideScript(LanguageMode language_mode) {
+    return v8_flags.process_wide_compilation_cache &&
+           IsEnabledScript(language_mode);
+  }
 
   Isolate* isolate() const { return isolate_; }
 
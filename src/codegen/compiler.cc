@@ -1580,7 +1580,9 @@ DeferredFinalizationJobData::DeferredFinalizationJobData(
 
 BackgroundCompileTask::BackgroundCompileTask(
     ScriptStreamingData* streamed_data, Isolate* isolate, ScriptType type,
-    ScriptCompiler::CompileOptions options)
+    ScriptCompiler::CompileOptions options,
+    ScriptCompiler::CompileHintCallback compile_hint_callback,
+    void* compile_hint_callback_data)
     : isolate_for_local_isolate_(isolate),
       flags_(UnoptimizedCompileFlags::ForToplevelCompile(
           isolate, true, construct_language_mode(v8_flags.use_strict),
@@ -1593,12 +1595,18 @@ BackgroundCompileTask::BackgroundCompileTask(
       worker_thread_runtime_call_stats_(
           isolate->counters()->worker_thread_runtime_call_stats()),
       timer_(isolate->counters()->compile_script_on_background()),
+      compile_hint_callback_(compile_hint_callback),
+      compile_hint_callback_data_(compile_hint_callback_data),
       start_position_(0),
       end_position_(0),
       function_literal_id_(kFunctionLiteralIdTopLevel) {
   if (options == ScriptCompiler::CompileOptions::kProduceCompileHints) {
     flags_.set_produce_compile_hints(true);
   }
+  if (options == ScriptCompiler::CompileOptions::kConsumeCompileHints &&
+      compile_hint_callback != nullptr) {
+    flags_.set_consume_compile_hints(true);
+  }
   DCHECK(is_streaming_compilation());
 }
 
@@ -1813,6 +1821,8 @@ void BackgroundCompileTask::Run(
   ParseInfo info(isolate, flags_, &compile_state_, reusable_state,
                  GetCurrentStackPosition() - stack_size_ * KB);
   info.set_character_stream(std::move(character_stream_));
+  info.set_compile_hint_callback(compile_hint_callback_,
+                                 compile_hint_callback_data_);
   if (is_streaming_compilation()) info.set_is_streaming_compilation();
 
   if (toplevel_script_compilation) {
@@ -2060,8 +2070,11 @@ void BackgroundMergeTask::BeginMergeInBackground(LocalIsolate* isolate,
             // Reset the old SFI's bytecode age so that it won't likely get
             // flushed right away. This operation might be racing against
             // concurrent modification by another thread, but such a race is not
-            // catastrophic.
-            old_sfi.GetBytecodeArray(isolate).set_bytecode_age(0);
+            // catastrophic. Bytecode in the shared heap is never aged.
+            BytecodeArray old_bytecode = old_sfi.GetBytecodeArray(isolate);
+            if (!old_bytecode.InSharedWritableHeap()) {
+              old_bytecode.set_bytecode_age(0);
+            }
           } else {
             // The old SFI can use the compiled data from the new SFI.
             new_compiled_data_for_cached_sfis_.push_back(
@@ -2411,6 +2424,7 @@ bool Compiler::CollectSourcePositions(Isolate* isolate,
   flags.set_is_reparse(true);
   // Prevent parallel tasks from being spawned by this job.
   flags.set_post_parallel_compile_tasks_for_eager_toplevel(false);
+  flags.set_post_parallel_compile_tasks_for_eager_inner(false);
   flags.set_post_parallel_compile_tasks_for_lazy(false);
 
   UnoptimizedCompileState compile_state;
@@ -3284,6 +3298,9 @@ MaybeHandle<SharedFunctionInfo> CompileScriptOnMainThread(
   ReusableUnoptimizedCompileState reusable_state(isolate);
   ParseInfo parse_info(isolate, flags, &compile_state, &reusable_state);
   parse_info.set_extension(extension);
+  parse_info.set_compile_hint_callback(
+      script_details.compile_hint_callback,
+      script_details.compile_hint_callback_data);
 
   Handle<Script> script;
   if (!maybe_script.ToHandle(&script)) {
@@ -3552,6 +3569,42 @@ MaybeHandle<SharedFunctionInfo> GetSharedFunctionInfoForScriptImpl(
     }
   }
 
+  if (use_compilation_cache && maybe_result.is_null() &&
+      natives == NOT_NATIVES_CODE &&
+      (compile_options == ScriptCompiler::kNoCompileOptions ||
+       compile_options == ScriptCompiler::kConsumeCodeCache)) {
+    // Then check whether another Isolate already compiled the script.
+    if (ProcessWideCompilationCache::Data data =
+            compilation_cache->LookupScriptInProcessWideCache(
+                source, script_details, language_mode)) {
+      NestedTimedHistogramScope timer(
+          isolate->counters()->compile_deserialize());
+      RCS_SCOPE(isolate, RuntimeCallCounterId::kCompileDeserialize);
+      TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+                   "V8.CompileDeserialize");
+      AlignedCachedData cached_data(data->data(),
+                                    static_cast<int>(data->size()));
+      Handle<SharedFunctionInfo> result;
+      if (CodeSerializer::Deserialize(isolate, &cached_data, source,
+                                      script_details.origin_options,
+                                      maybe_script)
+              .ToHandle(&result)) {
+        is_compiled_scope = result->is_compiled_scope(isolate);
+        if (is_compiled_scope.is_compiled()) {
+          // The serialized Script carries the details of the Isolate which
+          // produced it.
+          {
+            DisallowGarbageCollection no_gc;
+            SetScriptFieldsFromDetails(isolate, Script::cast(result->script()),
+                                       script_details, &no_gc);
+          }
+          maybe_result = result;
+          compilation_cache->PutScript(source, language_mode, result);
+        }
+      }
+    }
+  }
+
   if (maybe_result.is_null()) {
     // No cache entry found compile the script.
     if (v8_flags.stress_background_compile &&
@@ -3571,6 +3624,9 @@ MaybeHandle<SharedFunctionInfo> GetSharedFunctionInfoForScriptImpl(
               v8_flags.lazy);
 
       flags.set_is_eager(compile_options == ScriptCompiler::kEagerCompile);
+      flags.set_consume_compile_hints(
+          compile_options == ScriptCompiler::kConsumeCompileHints &&
+          script_details.compile_hint_callback != nullptr);
 
       if (Handle<Script> script; maybe_script.ToHandle(&script)) {
         flags.set_script_id(script->id());
@@ -3586,6 +3642,10 @@ MaybeHandle<SharedFunctionInfo> GetSharedFunctionInfoForScriptImpl(
     if (use_compilation_cache && maybe_result.ToHandle(&result)) {
       DCHECK(is_compiled_scope.is_compiled());
       compilation_cache->PutScript(source, language_mode, result);
+      if (natives == NOT_NATIVES_CODE) {
+        compilation_cache->PutScriptInProcessWideCache(source, language_mode,
+                                                       result);
+      }
     } else if (maybe_result.is_null() && natives != EXTENSION_CODE) {
       isolate->ReportPendingMessages();
     }
@@ -523,9 +523,11 @@ class V8_EXPORT_PRIVATE BackgroundCompileTask {
   // Creates a new task that when run will parse and compile the streamed
   // script associated with |data| and can be finalized with FinalizeScript.
   // Note: does not take ownership of |data|.
-  BackgroundCompileTask(ScriptStreamingData* data, Isolate* isolate,
-                        v8::ScriptType type,
-                        ScriptCompiler::CompileOptions options);
+  BackgroundCompileTask(
+      ScriptStreamingData* data, Isolate* isolate, v8::ScriptType type,
+      ScriptCompiler::CompileOptions options,
+      ScriptCompiler::CompileHintCallback compile_hint_callback = nullptr,
+      void* compile_hint_callback_data = nullptr);
   BackgroundCompileTask(const BackgroundCompileTask&) = delete;
   BackgroundCompileTask& operator=(const BackgroundCompileTask&) = delete;
   ~BackgroundCompileTask();
@@ -571,6 +573,8 @@ class V8_EXPORT_PRIVATE BackgroundCompileTask {
   int stack_size_;
   WorkerThreadRuntimeCallStats* worker_thread_runtime_call_stats_;
   TimedHistogram* timer_;
+  ScriptCompiler::CompileHintCallback compile_hint_callback_ = nullptr;
+  void* compile_hint_callback_data_ = nullptr;
 
   // Data needed for merging onto the main thread after background finalization.
   std::unique_ptr<PersistentHandles> persistent_handles_;
@@ -32,6 +32,9 @@ struct ScriptDetails {
   MaybeHandle<Object> host_defined_options;
   REPLMode repl_mode;
   const ScriptOriginOptions origin_options;
+  // Only used when compiling with kConsumeCompileHints.
+  v8::ScriptCompiler::CompileHintCallback compile_hint_callback = nullptr;
+  void* compile_hint_callback_data = nullptr;
 };
 
 }  // namespace internal
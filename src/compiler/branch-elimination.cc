@@ -10,6 +10,8 @@
 #include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/opcodes.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/compiler/type-cache.h"
 
 namespace v8 {
 namespace internal {
@@ -37,6 +39,8 @@ Reduction BranchElimination::Reduce(Node* node) {
       return ReduceLoop(node);
     case IrOpcode::kBranch:
       return ReduceBranch(node);
+    case IrOpcode::kCheckBounds:
+      return ReduceCheckBounds(node);
     case IrOpcode::kIfFalse:
       return ReduceIf(node, false);
     case IrOpcode::kIfTrue:
@@ -290,6 +294,15 @@ Reduction BranchElimination::ReduceTrapConditional(Node* node) {
       return Replace(control);  // Irrelevant argument
     }
   }
+  if (!trapping_condition &&
+      TrapIdOf(node->op()) == TrapId::kTrapMemOutOfBounds &&
+      IsMemoryAccessKnownInBounds(condition, from_input)) {
+    // A dominating bounds check already covered this access, remove it.
+    RelaxEffectsAndControls(node);
+    Node* control = NodeProperties::GetControlInput(node);
+    node->Kill();
+    return Replace(control);
+  }
   return UpdateStatesHelper(node, from_input, condition, node,
                             !trapping_condition, false);
 }
@@ -332,6 +345,164 @@ Reduction BranchElimination::ReduceDeoptimizeConditional(Node* node) {
                             condition_is_true, false);
 }
 
+Reduction BranchElimination::ReduceCheckBounds(Node* node) {
+  // A bounds check is redundant if it is dominated by a comparison of the same
+  // index and length, like the loop condition in
+  //
+  //   for (let i = 0; i < a.length; ++i) a[i] = ...;
+  //
+  // Typing alone can't prove this, since the type of {i} depends on the type of
+  // {a.length}, which is usually unknown. Redundant checks are turned into
+  // aborting checks, which don't need a deoptimization exit.
+  CheckBoundsParameters const& p = CheckBoundsParametersOf(node->op());
+  Node* index = NodeProperties::GetValueInput(node, 0);
+  Node* length = NodeProperties::GetValueInput(node, 1);
+  Node* control = NodeProperties::GetControlInput(node);
+  if (!(p.flags() & CheckBoundsFlag::kAbortOnOutOfBounds) &&
+      IsReduced(control) &&
+      IsIndexKnownInBounds(index, length, GetState(control))) {
+    NodeProperties::ChangeOp(
+        node, simplified()->CheckBounds(
+                  p.check_parameters().feedback(),
+                  p.flags() | CheckBoundsFlag::kAbortOnOutOfBounds));
+    Reduction reduction = TakeStatesFromFirstControl(node);
+    return reduction.Changed() ? reduction : Changed(node);
+  }
+  return TakeStatesFromFirstControl(node);
+}
+
+bool BranchElimination::IsIndexKnownInBounds(
+    Node* index, Node* length, ControlPathConditions conditions) {
+  // The comparisons below only imply 0 <= index < length for non-negative
+  // integers (in particular, not for -0, strings, or NaN).
+  if (!NodeProperties::GetType(index).Is(
+          TypeCache::Get()->kPositiveSafeInteger)) {
+    return false;
+  }
+  for (Node* use : index->uses()) {
+    if (use->op()->ValueInputCount() != 2) continue;
+    bool in_bounds_if;
+    switch (use->opcode()) {
+      case IrOpcode::kNumberLessThan:
+      case IrOpcode::kSpeculativeNumberLessThan:
+        // index < length
+        if (use->InputAt(0) != index || use->InputAt(1) != length) continue;
+        in_bounds_if = true;
+        break;
+      case IrOpcode::kNumberLessThanOrEqual:
+      case IrOpcode::kSpeculativeNumberLessThanOrEqual:
+        // !(length <= index)
+        if (use->InputAt(0) != length || use->InputAt(1) != index) continue;
+        in_bounds_if = false;
+        break;
+      default:
+        continue;
+    }
+    BranchCondition condition = conditions.LookupState(use);
+    if (condition.IsSet() && condition.is_true == in_bounds_if) return true;
+  }
+  return false;
+}
+
+namespace {
+
+// Matches the limit of a Wasm memory bounds check, which is either
+// {mem_size - end_offset} or a constant. Returns {mem_size} in {base} (or
+// nullptr for a constant limit), and {end_offset} (or the constant) in
+// {offset}. The MachineOperatorReducer turns {mem_size - end_offset} into
+// {mem_size + -end_offset}, and {mem_size - 0} into {mem_size}, so these forms
+// are matched as well.
+void MatchBoundsCheckLimit(Node* limit, Node** base, uint64_t* offset) {
+  switch (limit->opcode()) {
+    case IrOpcode::kInt32Constant:
+      *base = nullptr;
+      *offset = static_cast<uint32_t>(OpParameter<int32_t>(limit->op()));
+      return;
+    case IrOpcode::kInt64Constant:
+      *base = nullptr;
+      *offset = static_cast<uint64_t>(OpParameter<int64_t>(limit->op()));
+      return;
+    case IrOpcode::kInt32Sub: {
+      Int32BinopMatcher m(limit);
+      if (!m.right().HasResolvedValue()) break;
+      *base = m.left().node();
+      *offset = static_cast<uint32_t>(m.right().ResolvedValue());
+      return;
+    }
+    case IrOpcode::kInt64Sub: {
+      Int64BinopMatcher m(limit);
+      if (!m.right().HasResolvedValue()) break;
+      *base = m.left().node();
+      *offset = static_cast<uint64_t>(m.right().ResolvedValue());
+      return;
+    }
+    case IrOpcode::kInt32Add: {
+      Int32BinopMatcher m(limit);
+      if (!m.right().HasResolvedValue() || m.right().ResolvedValue() >= 0) {
+        break;
+      }
+      *base = m.left().node();
+      *offset = uint32_t{0} - static_cast<uint32_t>(m.right().ResolvedValue());
+      return;
+    }
+    case IrOpcode::kInt64Add: {
+      Int64BinopMatcher m(limit);
+      if (!m.right().HasResolvedValue() || m.right().ResolvedValue() >= 0) {
+        break;
+      }
+      *base = m.left().node();
+      *offset = uint64_t{0} - static_cast<uint64_t>(m.right().ResolvedValue());
+      return;
+    }
+    default:
+      break;
+  }
+  // Any other limit is {limit - 0}.
+  *base = limit;
+  *offset = 0;
+}
+
+bool IsMemoryBoundsCheck(Node* node) {
+  return node->opcode() == IrOpcode::kTrapUnless &&
+         TrapIdOf(node->op()) == TrapId::kTrapMemOutOfBounds;
+}
+
+}  // namespace
+
+bool BranchElimination::IsMemoryAccessKnownInBounds(
+    Node* condition, ControlPathConditions conditions) {
+  // A bounds check has the form {index < mem_size - end_offset}. It is implied
+  // by a dominating check {index < mem_size - other_end_offset} of the same
+  // index if {other_end_offset >= end_offset}, i.e. by the check of an access
+  // at a larger offset from the same index.
+  if (condition->opcode() != IrOpcode::kUint32LessThan &&
+      condition->opcode() != IrOpcode::kUint64LessThan) {
+    return false;
+  }
+  Node* index = condition->InputAt(0);
+  Node* base;
+  uint64_t offset;
+  MatchBoundsCheckLimit(condition->InputAt(1), &base, &offset);
+  for (Node* use : index->uses()) {
+    if (use == condition || use->opcode() != condition->opcode() ||
+        use->InputAt(0) != index) {
+      continue;
+    }
+    Node* other_base;
+    uint64_t other_offset;
+    MatchBoundsCheckLimit(use->InputAt(1), &other_base, &other_offset);
+    if (other_base != base) continue;
+    if (base ? other_offset < offset : other_offset > offset) continue;
+    BranchCondition known = conditions.LookupState(use);
+    if (!known.IsSet() || !known.is_true) continue;
+    // Only a bounds check guarantees that {mem_size - other_end_offset} did not
+    // underflow (otherwise it would have trapped on an earlier check).
+    if (base != nullptr && !IsMemoryBoundsCheck(known.branch)) continue;
+    return true;
+  }
+  return false;
+}
+
 Reduction BranchElimination::ReduceIf(Node* node, bool is_true_branch) {
   // Add the condition to the list arriving from the input branch.
   Node* branch = NodeProperties::GetControlInput(node, 0);
@@ -399,6 +570,10 @@ CommonOperatorBuilder* BranchElimination::common() const {
   return jsgraph()->common();
 }
 
+SimplifiedOperatorBuilder* BranchElimination::simplified() const {
+  return jsgraph()->simplified();
+}
+
 // Workaround a gcc bug causing link errors.
 // Related issue: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=105848
 template bool DefaultConstruct<bool>(Zone* zone);
@@ -16,6 +16,7 @@ namespace compiler {
 // Forward declarations.
 class CommonOperatorBuilder;
 class JSGraph;
+class SimplifiedOperatorBuilder;
 class SourcePositionTable;
 
 // Represents a condition along with its value in the current control path.
@@ -62,6 +63,7 @@ class V8_EXPORT_PRIVATE BranchElimination final
       ControlPathState<BranchCondition, kUniqueInstance>;
 
   Reduction ReduceBranch(Node* node);
+  Reduction ReduceCheckBounds(Node* node);
   Reduction ReduceDeoptimizeConditional(Node* node);
   Reduction ReduceIf(Node* node, bool is_true_branch);
   Reduction ReduceTrapConditional(Node* node);
@@ -71,6 +73,10 @@ class V8_EXPORT_PRIVATE BranchElimination final
   Reduction ReduceOtherControl(Node* node);
   void SimplifyBranchCondition(Node* branch);
   bool TryEliminateBranchWithPhiCondition(Node* branch, Node* phi, Node* merge);
+  bool IsIndexKnownInBounds(Node* index, Node* length,
+                            ControlPathConditions conditions);
+  bool IsMemoryAccessKnownInBounds(Node* condition,
+                                   ControlPathConditions conditions);
   Reduction UpdateStatesHelper(Node* node,
                                ControlPathConditions prev_conditions,
                                Node* current_condition, Node* current_branch,
@@ -86,6 +92,7 @@ class V8_EXPORT_PRIVATE BranchElimination final
   JSGraph* jsgraph() const { return jsgraph_; }
   Isolate* isolate() const;
   CommonOperatorBuilder* common() const;
+  SimplifiedOperatorBuilder* simplified() const;
 
   JSGraph* const jsgraph_;
 
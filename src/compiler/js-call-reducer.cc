@@ -42,6 +42,11 @@
 #include "src/objects/intl-objects.h"
 #endif
 
+#if V8_ENABLE_WEBASSEMBLY
+#include "src/wasm/wasm-module.h"
+#include "src/wasm/wasm-opcodes.h"
+#endif  // V8_ENABLE_WEBASSEMBLY
+
 namespace v8 {
 namespace internal {
 namespace compiler {
@@ -3549,17 +3554,30 @@ Reduction JSCallReducer::ReduceArraySome(Node* node,
 
 namespace {
 
-bool CanInlineJSToWasmCall(const wasm::FunctionSig* wasm_signature) {
+bool CanInlineJSToWasmCall(const wasm::FunctionSig* wasm_signature,
+                           const wasm::WasmModule* wasm_module) {
+  if (!wasm::IsJSCompatibleSignature(wasm_signature)) return false;
+
+  // The lazy deopt continuation after the call can only pass on a single
+  // return value.
   if (wasm_signature->return_count() > 1) {
     return false;
   }
 
-  for (auto type : wasm_signature->all()) {
 #if defined(V8_TARGET_ARCH_32_BIT)
+  for (auto type : wasm_signature->all()) {
     if (type == wasm::kWasmI64) return false;
+  }
 #endif
-    if (type != wasm::kWasmI32 && type != wasm::kWasmI64 &&
-        type != wasm::kWasmF32 && type != wasm::kWasmF64) {
+
+  // The lazy deopt continuation also passes the returned reference on as is,
+  // while function references have to be converted to their JS function.
+  if (wasm_signature->return_count() == 1) {
+    wasm::ValueType type = wasm_signature->GetReturn();
+    if (type.is_object_reference() &&
+        (type.heap_representation() == wasm::HeapType::kFunc ||
+         (type.has_index() &&
+          wasm_module->has_signature(type.ref_index())))) {
       return false;
     }
   }
@@ -3582,14 +3600,14 @@ Reduction JSCallReducer::ReduceCallWasmFunction(
   }
 
   const wasm::FunctionSig* wasm_signature = shared.wasm_function_signature();
-  if (!CanInlineJSToWasmCall(wasm_signature)) {
+  const wasm::WasmModule* wasm_module = shared.wasm_module();
+  if (!CanInlineJSToWasmCall(wasm_signature, wasm_module)) {
     return NoChange();
   }
 
   // Signal TurboFan that it should run the 'wasm-inlining' phase.
   has_wasm_calls_ = true;
 
-  const wasm::WasmModule* wasm_module = shared.wasm_module();
   const Operator* op =
       javascript()->CallWasm(wasm_module, wasm_signature, p.feedback());
 
@@ -22,6 +22,13 @@ namespace compiler {
     }                                      \
   } while (false)
 
+// The simd128 operations that are packed into their simd256 counterparts.
+// Only add operations whose simd256 form the instruction selector supports.
+#define SIMD128_BINOP_TO_SIMD256(V) \
+  V(F32x4Add, F32x8Add)               \
+  V(F32x4Sub, F32x8Sub)               \
+  V(F32x4Mul, F32x8Mul)
+
 namespace {
 
 // Currently, only Load/ProtectedLoad/LoadTransfrom are supported.
@@ -560,8 +567,10 @@ PackNode* SLPTree::BuildTreeRec(const ZoneVector<Node*>& node_group,
       PopStack();
       return pnode;
     }
-    case IrOpcode::kF32x4Add:
-    case IrOpcode::kF32x4Mul: {
+#define CASE(from, to) case IrOpcode::k##from:
+      SIMD128_BINOP_TO_SIMD256(CASE)
+#undef CASE
+      {
       TRACE("Added a vector of un/bin/ter op.\n");
       PackNode* pnode =
           NewPackNodeAndRecurs(node_group, 0, value_in_count, recursion_depth);
@@ -730,12 +739,12 @@ Node* Revectorizer::VectorizeTree(PackNode* pnode) {
       inputs[input_count - 1] = NodeProperties::GetControlInput(node0);
       break;
     }
-    case IrOpcode::kF32x4Add:
-      new_op = mcgraph_->machine()->F32x8Add();
-      break;
-    case IrOpcode::kF32x4Mul:
-      new_op = mcgraph_->machine()->F32x8Mul();
-      break;
+#define CASE(from, to)                  \
+  case IrOpcode::k##from:               \
+    new_op = mcgraph_->machine()->to(); \
+    break;
+      SIMD128_BINOP_TO_SIMD256(CASE)
+#undef CASE
     case IrOpcode::kProtectedLoad: {
       DCHECK_EQ(LoadRepresentationOf(node0->op()).representation(),
                 MachineRepresentation::kSimd128);
@@ -959,6 +968,9 @@ void Revectorizer::PrintStores(ZoneMap<Node*, StoreNodeSet>* store_chains) {
   }
 }
 
+#undef SIMD128_BINOP_TO_SIMD256
+#undef TRACE
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,172 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/late-load-elimination-reducer.h"
+
+#include <algorithm>
+
+#include "src/base/small-vector.h"
+#include "src/compiler/turboshaft/memory-aliasing.h"
+#include "src/compiler/turboshaft/optimization-phase.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+void LateLoadEliminationAnalyzer::Run() {
+  for (const Block& block : graph_.blocks()) {
+    BeginBlock(block);
+
+    for (OpIndex index : graph_.OperationIndices(block)) {
+      const Operation& op = graph_.Get(index);
+      if (ShouldSkipOperation(op)) continue;
+
+      if (const LoadOp* load = op.TryCast<LoadOp>()) {
+        ProcessLoad(index, *load);
+      } else if (const StoreOp* store = op.TryCast<StoreOp>()) {
+        ProcessStore(index, *store);
+      } else if (op.Properties().can_write) {
+        InvalidateEverything();
+      }
+    }
+
+    block_exit_snapshots_[block.index()] = table_.Seal();
+  }
+}
+
+void LateLoadEliminationAnalyzer::BeginBlock(const Block& block) {
+  if (block.IsLoop()) {
+    // The backedge hasn't been visited yet, and could have modified any field.
+    table_.StartNewSnapshot();
+    return;
+  }
+
+  base::SmallVector<Snapshot, 4> predecessor_snapshots;
+  for (const Block* predecessor : block.Predecessors()) {
+    base::Optional<Snapshot> snapshot =
+        block_exit_snapshots_[predecessor->index()];
+    DCHECK(snapshot.has_value());
+    predecessor_snapshots.push_back(*snapshot);
+  }
+
+  table_.StartNewSnapshot(
+      base::VectorOf(predecessor_snapshots),
+      [](Key key, base::Vector<const FieldContent> contents) -> FieldContent {
+        if (!key.data().base.valid()) {
+          // Barrier: the most recent barrier of all predecessors applies.
+          FieldContent barrier = contents[0];
+          for (const FieldContent& content : contents) {
+            barrier.timestamp = std::max(barrier.timestamp, content.timestamp);
+          }
+          return barrier;
+        }
+        for (const FieldContent& content : contents) {
+          if (!(content == contents[0])) return FieldContent{};
+        }
+        return contents[0];
+      });
+}
+
+void LateLoadEliminationAnalyzer::ProcessLoad(OpIndex index,
+                                              const LoadOp& load) {
+  if (!IsTracked(load.kind, load.index())) return;
+
+  Key key = GetOrCreateKey(load.base(), load.offset);
+  FieldContent content = table_.Get(key);
+  if (content.source.valid() &&
+      content.timestamp > table_.Get(barrier_).timestamp) {
+    OpIndex value = ValueForLoad(content.source, load);
+    if (value.valid()) {
+      replacements_[index] = value;
+      return;
+    }
+  }
+  table_.Set(key, FieldContent{index, next_timestamp_++});
+}
+
+void LateLoadEliminationAnalyzer::ProcessStore(OpIndex index,
+                                               const StoreOp& store) {
+  if (!IsTracked(store.kind, store.index())) {
+    InvalidateEverything();
+    return;
+  }
+  InvalidateMayAlias(store.base(), store.offset,
+                     store.stored_rep.SizeInBytes());
+  table_.Set(GetOrCreateKey(store.base(), store.offset),
+             FieldContent{index, next_timestamp_++});
+}
+
+void LateLoadEliminationAnalyzer::InvalidateMayAlias(OpIndex base,
+                                                     int32_t offset, int size) {
+  for (int32_t field_offset = offset - kMaxTrackedAccessSize + 1;
+       field_offset < offset + size; ++field_offset) {
+    auto it = keys_by_offset_.find(field_offset);
+    if (it == keys_by_offset_.end()) continue;
+    for (Key key : it->second) {
+      FieldContent content = table_.Get(key);
+      if (!content.source.valid()) continue;
+      if (!RangesOverlap(field_offset,
+                         AccessRepresentation(content.source).SizeInBytes(),
+                         offset, size)) {
+        continue;
+      }
+      if (!MayAlias(graph_, key.data().base, base)) continue;
+      table_.Set(key, FieldContent{});
+    }
+  }
+}
+
+void LateLoadEliminationAnalyzer::InvalidateEverything() {
+  table_.Set(barrier_, FieldContent{OpIndex::Invalid(), next_timestamp_++});
+}
+
+MemoryRepresentation LateLoadEliminationAnalyzer::AccessRepresentation(
+    OpIndex source) const {
+  const Operation& op = graph_.Get(source);
+  if (const StoreOp* store = op.TryCast<StoreOp>()) return store->stored_rep;
+  return op.Cast<LoadOp>().loaded_rep;
+}
+
+OpIndex LateLoadEliminationAnalyzer::ValueForLoad(OpIndex source,
+                                                  const LoadOp& load) const {
+  auto SameBits = [](MemoryRepresentation a, MemoryRepresentation b) {
+    return a == b || (a.IsTagged() && b.IsTagged());
+  };
+  const Operation& op = graph_.Get(source);
+  if (const LoadOp* previous = op.TryCast<LoadOp>()) {
+    if (SameBits(previous->loaded_rep, load.loaded_rep) &&
+        previous->result_rep == load.result_rep) {
+      return source;
+    }
+    return OpIndex::Invalid();
+  }
+
+  const StoreOp& store = op.Cast<StoreOp>();
+  if (!SameBits(store.stored_rep, load.loaded_rep)) return OpIndex::Invalid();
+  // Loads of small integers sign- or zero-extend the loaded value, which isn't
+  // necessarily the value that has been stored.
+  if (store.stored_rep.SizeInBytes() < 4) return OpIndex::Invalid();
+  if (store.stored_rep == MemoryRepresentation::SandboxedPointer()) {
+    return OpIndex::Invalid();
+  }
+  base::Vector<const RegisterRepresentation> value_reps =
+      graph_.Get(store.value()).outputs_rep();
+  if (value_reps.size() != 1 || value_reps[0] != load.result_rep) {
+    return OpIndex::Invalid();
+  }
+  return store.value();
+}
+
+LateLoadEliminationAnalyzer::Key LateLoadEliminationAnalyzer::GetOrCreateKey(
+    OpIndex base, int32_t offset) {
+  auto [it, inserted] =
+      keys_.try_emplace(std::pair{base.id(), offset}, barrier_);
+  if (inserted) {
+    it->second = table_.NewKey(FieldData{base, offset}, FieldContent{});
+    auto [offset_it, offset_inserted] =
+        keys_by_offset_.try_emplace(offset, phase_zone_);
+    offset_it->second.push_back(it->second);
+  }
+  return it->second;
+}
+
+}  // namespace v8::internal::compiler::turboshaft
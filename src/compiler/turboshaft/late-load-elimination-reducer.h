@@ -0,0 +1,132 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_LATE_LOAD_ELIMINATION_REDUCER_H_
+#define V8_COMPILER_TURBOSHAFT_LATE_LOAD_ELIMINATION_REDUCER_H_
+
+#include <utility>
+
+#include "src/base/optional.h"
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/compiler/turboshaft/sidetable.h"
+#include "src/compiler/turboshaft/snapshot-table.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+// LateLoadElimination replaces loads from fields whose content is already known
+// (because the field was stored to, or loaded from, earlier on every path) by
+// the known value.
+//
+// The analysis walks the graph forwards, blocks in order. For every field
+// (identified by a base and an offset), the SnapshotTable records which
+// operation last wrote or read it: either a StoreOp (whose stored value is the
+// content of the field) or a LoadOp (which is itself the content of the field).
+// As in StoreStoreElimination, entries are timestamped, and operations that can
+// write arbitrary memory (calls, indexed or untagged stores, ...) merely bump a
+// global barrier; an entry is valid only if it is newer than the barrier.
+// Because an entry can only survive a merge if all predecessors agree on it, the
+// operation it refers to is guaranteed to dominate the merge, and thus every
+// later load of the field.
+//
+// Loop headers start with an empty state, since the loop body could modify any
+// field.
+class LateLoadEliminationAnalyzer {
+ public:
+  LateLoadEliminationAnalyzer(const Graph& graph, Zone* phase_zone)
+      : graph_(graph),
+        phase_zone_(phase_zone),
+        table_(phase_zone),
+        block_exit_snapshots_(graph.block_count(), base::nullopt, phase_zone),
+        replacements_(graph.op_id_count(), OpIndex::Invalid(), phase_zone),
+        keys_(phase_zone),
+        keys_by_offset_(phase_zone) {}
+
+  void Run();
+
+  // Returns the operation (of the input graph) that should replace {load}, or
+  // OpIndex::Invalid() if {load} cannot be eliminated.
+  OpIndex Replacement(OpIndex load) const { return replacements_[load]; }
+
+ private:
+  struct FieldContent {
+    // The last StoreOp or LoadOp that accessed the field.
+    OpIndex source = OpIndex::Invalid();
+    uint32_t timestamp = 0;
+
+    bool operator==(const FieldContent& other) const {
+      return source == other.source && timestamp == other.timestamp;
+    }
+  };
+  struct FieldData {
+    // An invalid {base} denotes the barrier entry.
+    OpIndex base;
+    int32_t offset;
+  };
+  using Table = SnapshotTable<FieldContent, FieldData>;
+  using Key = Table::Key;
+  using Snapshot = Table::Snapshot;
+
+  void BeginBlock(const Block& block);
+  void ProcessLoad(OpIndex index, const LoadOp& load);
+  void ProcessStore(OpIndex index, const StoreOp& store);
+  void InvalidateMayAlias(OpIndex base, int32_t offset, int size);
+  void InvalidateEverything();
+
+  bool IsTracked(const LoadOp::Kind& kind, OpIndex index) const {
+    return kind.tagged_base && !kind.with_trap_handler && !index.valid();
+  }
+  // Returns the value that {load} would read from a field whose content was
+  // last accessed by {source}, or OpIndex::Invalid() if this value is not
+  // directly available.
+  OpIndex ValueForLoad(OpIndex source, const LoadOp& load) const;
+  MemoryRepresentation AccessRepresentation(OpIndex source) const;
+  Key GetOrCreateKey(OpIndex base, int32_t offset);
+
+  const Graph& graph_;
+  Zone* phase_zone_;
+  Table table_;
+  Key barrier_ =
+      table_.NewKey(FieldData{OpIndex::Invalid(), 0}, FieldContent{});
+  uint32_t next_timestamp_ = 1;
+  FixedBlockSidetable<base::Optional<Snapshot>> block_exit_snapshots_;
+  FixedSidetable<OpIndex> replacements_;
+  ZoneMap<std::pair<uint32_t, int32_t>, Key> keys_;
+  // All keys ever created for a given offset, so that stores can invalidate the
+  // fields they might overwrite.
+  ZoneMap<int32_t, ZoneVector<Key>> keys_by_offset_;
+};
+
+template <class Next>
+class LateLoadEliminationReducer : public Next {
+ public:
+  using Next::Asm;
+
+  template <class... Args>
+  explicit LateLoadEliminationReducer(const std::tuple<Args...>& args)
+      : Next(args), analyzer_(Asm().input_graph(), Asm().phase_zone()) {}
+
+  void Analyze() {
+    // Running the analysis after the reducers further down the stack, so that
+    // operations they already marked as unused are ignored.
+    Next::Analyze();
+    if (v8_flags.turboshaft_load_elimination) analyzer_.Run();
+  }
+
+  OpIndex ReduceInputGraphLoad(OpIndex ig_index, const LoadOp& load) {
+    OpIndex replacement = analyzer_.Replacement(ig_index);
+    if (replacement.valid()) return Asm().MapToNewGraph(replacement);
+    return Next::ReduceInputGraphLoad(ig_index, load);
+  }
+
+ private:
+  LateLoadEliminationAnalyzer analyzer_;
+};
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_LATE_LOAD_ELIMINATION_REDUCER_H_
@@ -0,0 +1,63 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_MEMORY_ALIASING_H_
+#define V8_COMPILER_TURBOSHAFT_MEMORY_ALIASING_H_
+
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/compiler/turboshaft/operations.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+// A cheap, purely structural object-aliasing query shared by the Turboshaft
+// memory optimizations (load elimination and store-store elimination).
+//
+// Two different operations producing object bases may refer to the same object
+// unless one of them is a fresh allocation and the other one is either another
+// allocation or a value that existed before the allocation happened
+// (parameters, OSR values and heap constants). Anything else (Phis, loads,
+// calls, ...) could have been produced from the allocation and thus has to be
+// considered as aliasing it.
+inline bool IsFreshAllocation(const Graph& graph, OpIndex base) {
+  return graph.Get(base).Is<AllocateOp>();
+}
+
+inline bool IsPreexistingObject(const Graph& graph, OpIndex base) {
+  const Operation& op = graph.Get(base);
+  if (op.Is<ParameterOp>() || op.Is<OsrValueOp>()) return true;
+  if (const ConstantOp* constant = op.TryCast<ConstantOp>()) {
+    return constant->kind == ConstantOp::Kind::kHeapObject ||
+           constant->kind == ConstantOp::Kind::kCompressedHeapObject;
+  }
+  return false;
+}
+
+inline bool MayAlias(const Graph& graph, OpIndex base1, OpIndex base2) {
+  if (base1 == base2) return true;
+  if (IsFreshAllocation(graph, base1)) {
+    return !IsFreshAllocation(graph, base2) &&
+           !IsPreexistingObject(graph, base2);
+  }
+  if (IsFreshAllocation(graph, base2)) {
+    return !IsPreexistingObject(graph, base1);
+  }
+  return true;
+}
+
+// Returns true if the byte ranges [offset1, offset1 + size1) and
+// [offset2, offset2 + size2) intersect.
+inline bool RangesOverlap(int32_t offset1, int size1, int32_t offset2,
+                          int size2) {
+  return offset1 < offset2 + size2 && offset2 < offset1 + size1;
+}
+
+// The largest memory access (in bytes) that the memory analyses track
+// precisely. Accesses to a given offset can only overlap with tracked accesses
+// whose offset is at most this many bytes lower.
+static constexpr int kMaxTrackedAccessSize = 8;
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_MEMORY_ALIASING_H_
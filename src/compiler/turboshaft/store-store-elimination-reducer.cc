@@ -0,0 +1,131 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/store-store-elimination-reducer.h"
+
+#include <algorithm>
+
+#include "src/base/small-vector.h"
+#include "src/compiler/turboshaft/memory-aliasing.h"
+#include "src/compiler/turboshaft/optimization-phase.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+void StoreStoreEliminationAnalyzer::Run() {
+  for (uint32_t id = graph_.block_count(); id > 0; --id) {
+    const Block& block = graph_.Get(BlockIndex(id - 1));
+    BeginBlock(block);
+
+    auto op_range = graph_.OperationIndices(block);
+    for (auto it = op_range.end(); it != op_range.begin();) {
+      --it;
+      OpIndex index = *it;
+      const Operation& op = graph_.Get(index);
+      if (ShouldSkipOperation(op)) continue;
+
+      if (const StoreOp* store = op.TryCast<StoreOp>()) {
+        ProcessStore(index, *store);
+      } else if (const LoadOp* load = op.TryCast<LoadOp>()) {
+        ProcessLoad(*load);
+      } else {
+        OpProperties properties = op.Properties();
+        // Block terminators don't need special care: blocks without successors
+        // start with an empty state, in which every field is observable.
+        if (properties.can_read || properties.can_abort ||
+            properties.can_allocate) {
+          ObserveEverything();
+        }
+      }
+    }
+
+    block_entry_snapshots_[block.index()] = table_.Seal();
+  }
+}
+
+void StoreStoreEliminationAnalyzer::BeginBlock(const Block& block) {
+  base::SmallVector<Snapshot, 4> successor_snapshots;
+  for (const Block* successor : SuccessorBlocks(block.LastOperation(graph_))) {
+    base::Optional<Snapshot> snapshot =
+        block_entry_snapshots_[successor->index()];
+    if (!snapshot.has_value()) {
+      // {successor} is a loop header that hasn't been processed yet. We
+      // conservatively consider that everything is observable.
+      DCHECK(successor->IsLoop());
+      table_.StartNewSnapshot();
+      return;
+    }
+    successor_snapshots.push_back(*snapshot);
+  }
+
+  table_.StartNewSnapshot(
+      base::VectorOf(successor_snapshots),
+      [](Key key, base::Vector<const uint32_t> timestamps) -> uint32_t {
+        if (!key.data().base.valid()) {
+          // Barrier: the most recent barrier of all successors applies.
+          return *std::max_element(timestamps.begin(), timestamps.end());
+        }
+        for (uint32_t timestamp : timestamps) {
+          if (timestamp != timestamps[0]) return 0;
+        }
+        return timestamps[0];
+      });
+}
+
+void StoreStoreEliminationAnalyzer::ProcessStore(OpIndex index,
+                                                 const StoreOp& store) {
+  if (store.kind.with_trap_handler) {
+    // A trap would make all previous stores observable.
+    ObserveEverything();
+    return;
+  }
+  if (!IsTracked(store.kind, store.index())) return;
+
+  Key key = GetOrCreateKey(store.base(), store.offset,
+                           store.stored_rep.SizeInBytes());
+  if (IsUnobservable(key)) {
+    eliminable_stores_.insert(index);
+  }
+  // Previous stores to the same field are now overwritten by {store}.
+  table_.Set(key, next_timestamp_++);
+}
+
+void StoreStoreEliminationAnalyzer::ProcessLoad(const LoadOp& load) {
+  if (!IsTracked(load.kind, load.index())) {
+    // Loads with an index, or from untagged bases, could read from any field.
+    ObserveEverything();
+    return;
+  }
+  int size = load.loaded_rep.SizeInBytes();
+  for (int32_t offset = load.offset - kMaxTrackedAccessSize + 1;
+       offset < load.offset + size; ++offset) {
+    auto it = keys_by_offset_.find(offset);
+    if (it == keys_by_offset_.end()) continue;
+    for (Key key : it->second) {
+      const FieldData& field = key.data();
+      if (!RangesOverlap(field.offset, field.size, load.offset, size)) continue;
+      if (!MayAlias(graph_, field.base, load.base())) continue;
+      table_.Set(key, 0);
+    }
+  }
+}
+
+void StoreStoreEliminationAnalyzer::ObserveEverything() {
+  table_.Set(barrier_, next_timestamp_++);
+}
+
+StoreStoreEliminationAnalyzer::Key
+StoreStoreEliminationAnalyzer::GetOrCreateKey(OpIndex base, int32_t offset,
+                                              uint8_t size) {
+  auto [it, inserted] =
+      keys_.try_emplace(std::tuple{base.id(), offset, size}, barrier_);
+  if (inserted) {
+    it->second = table_.NewKey(FieldData{base, offset, size}, 0);
+    auto [offset_it, offset_inserted] =
+        keys_by_offset_.try_emplace(offset, phase_zone_);
+    offset_it->second.push_back(it->second);
+  }
+  return it->second;
+}
+
+}  // namespace v8::internal::compiler::turboshaft
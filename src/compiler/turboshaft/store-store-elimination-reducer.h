@@ -0,0 +1,124 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_STORE_STORE_ELIMINATION_REDUCER_H_
+#define V8_COMPILER_TURBOSHAFT_STORE_STORE_ELIMINATION_REDUCER_H_
+
+#include <tuple>
+
+#include "src/base/optional.h"
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/compiler/turboshaft/sidetable.h"
+#include "src/compiler/turboshaft/snapshot-table.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+// StoreStoreElimination removes stores that are overwritten by a later store to
+// the same field before the stored value can be observed.
+//
+// The analysis walks the graph backwards (blocks in reverse order, operations
+// in reverse order within a block) and maintains, in a SnapshotTable, which
+// fields are "unobservable": a field is unobservable if, on every path from the
+// current program point, it is overwritten before anything can read it. A
+// store to an unobservable field is redundant.
+//
+// To avoid having to iterate over all fields whenever an operation observes
+// everything (calls, deopts, allocations, ...), unobservability is represented
+// with timestamps: a field is marked unobservable by setting its entry to a
+// fresh timestamp, and an operation observing the whole heap bumps a global
+// barrier. A field is unobservable if its timestamp is newer than the barrier.
+// Timestamps are globally monotonic, which makes merging the states of
+// different successors straight-forward:
+//  - the barrier of a merged state is the most recent one of the successors.
+//  - a field is unobservable in the merged state if it was marked with the
+//    same timestamp in all successors.
+//
+// Loop backedges are not processed precisely: blocks jumping to a loop header
+// conservatively start with every field being observable.
+class StoreStoreEliminationAnalyzer {
+ public:
+  StoreStoreEliminationAnalyzer(const Graph& graph, Zone* phase_zone)
+      : graph_(graph),
+        phase_zone_(phase_zone),
+        table_(phase_zone),
+        block_entry_snapshots_(graph.block_count(), base::nullopt, phase_zone),
+        eliminable_stores_(phase_zone),
+        keys_(phase_zone),
+        keys_by_offset_(phase_zone) {}
+
+  void Run();
+
+  bool IsEliminable(OpIndex store) const {
+    return eliminable_stores_.find(store) != eliminable_stores_.end();
+  }
+
+ private:
+  struct FieldData {
+    // An invalid {base} denotes the barrier entry.
+    OpIndex base;
+    int32_t offset;
+    uint8_t size;
+  };
+  using Table = SnapshotTable<uint32_t, FieldData>;
+  using Key = Table::Key;
+  using Snapshot = Table::Snapshot;
+
+  void BeginBlock(const Block& block);
+  void ProcessStore(OpIndex index, const StoreOp& store);
+  void ProcessLoad(const LoadOp& load);
+  void ObserveEverything();
+
+  bool IsTracked(const LoadOp::Kind& kind, OpIndex index) const {
+    return kind.tagged_base && !kind.with_trap_handler && !index.valid();
+  }
+  bool IsUnobservable(Key key) {
+    return table_.Get(key) > table_.Get(barrier_);
+  }
+  Key GetOrCreateKey(OpIndex base, int32_t offset, uint8_t size);
+
+  const Graph& graph_;
+  Zone* phase_zone_;
+  Table table_;
+  Key barrier_ = table_.NewKey(FieldData{OpIndex::Invalid(), 0, 0}, 0);
+  uint32_t next_timestamp_ = 1;
+  FixedBlockSidetable<base::Optional<Snapshot>> block_entry_snapshots_;
+  ZoneUnorderedSet<OpIndex> eliminable_stores_;
+  ZoneMap<std::tuple<uint32_t, int32_t, uint8_t>, Key> keys_;
+  // All keys ever created for a given offset, so that loads can invalidate the
+  // fields they might read from.
+  ZoneMap<int32_t, ZoneVector<Key>> keys_by_offset_;
+};
+
+template <class Next>
+class StoreStoreEliminationReducer : public Next {
+ public:
+  using Next::Asm;
+
+  template <class... Args>
+  explicit StoreStoreEliminationReducer(const std::tuple<Args...>& args)
+      : Next(args), analyzer_(Asm().input_graph(), Asm().phase_zone()) {}
+
+  void Analyze() {
+    // Running the analysis after the reducers further down the stack, so that
+    // operations they already marked as unused are ignored.
+    Next::Analyze();
+    if (v8_flags.turboshaft_store_elimination) analyzer_.Run();
+  }
+
+  OpIndex ReduceInputGraphStore(OpIndex ig_index, const StoreOp& store) {
+    if (analyzer_.IsEliminable(ig_index)) return OpIndex::Invalid();
+    return Next::ReduceInputGraphStore(ig_index, store);
+  }
+
+ private:
+  StoreStoreEliminationAnalyzer analyzer_;
+};
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_STORE_STORE_ELIMINATION_REDUCER_H_
@@ -6885,8 +6885,11 @@ class WasmWrapperGraphBuilder : public WasmGraphBuilder {
     if (sig_->return_count() == 0) {
       jsval = UndefinedValue();
     } else if (sig_->return_count() == 1) {
-      jsval = !do_conversion ? rets[0]
-                             : ToJS(rets[0], sig_->GetReturn(), js_context);
+      // Without {do_conversion}, numeric results are converted by the caller,
+      // but references still have to be converted here.
+      jsval = !do_conversion && !sig_->GetReturn().is_reference()
+                  ? rets[0]
+                  : ToJS(rets[0], sig_->GetReturn(), js_context);
     } else {
       int32_t return_count = static_cast<int32_t>(sig_->return_count());
       Node* size = gasm_->NumberConstant(return_count);
@@ -7036,6 +7039,11 @@ class WasmWrapperGraphBuilder : public WasmGraphBuilder {
       if (do_conversion) {
         args[i + 1] = FromJS(params[i + 1], js_context, sig_->GetParam(i),
                              module_, frame_state);
+      } else if (sig_->GetParam(i).is_reference()) {
+        // Only numeric parameters are converted by the caller; references are
+        // type checked and converted here.
+        args[i + 1] = FromJS(params[i + 1], js_context, sig_->GetParam(i),
+                             module_, frame_state);
       } else {
         Node* wasm_param = params[i + 1];
 
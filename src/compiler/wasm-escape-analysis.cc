@@ -5,12 +5,70 @@
 #include "src/compiler/wasm-escape-analysis.h"
 
 #include "src/compiler/machine-graph.h"
+#include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
 
 namespace v8 {
 namespace internal {
 namespace compiler {
 
+namespace {
+
+// Loads from an object are only forwarded from stores within this distance on
+// the effect chain, to avoid quadratic behavior.
+constexpr int kMaxEffectChainWalk = 64;
+
+bool IsStore(Node* node) {
+  return node->opcode() == IrOpcode::kStoreToObject ||
+         node->opcode() == IrOpcode::kInitializeImmutableInObject;
+}
+
+bool IsLoad(Node* node) {
+  return node->opcode() == IrOpcode::kLoadFromObject ||
+         node->opcode() == IrOpcode::kLoadImmutableFromObject;
+}
+
+bool SameOffset(Node* a, Node* b) {
+  if (a == b) return true;
+  IntPtrMatcher ma(a);
+  IntPtrMatcher mb(b);
+  return ma.HasResolvedValue() && mb.HasResolvedValue() &&
+         ma.ResolvedValue() == mb.ResolvedValue();
+}
+
+// Whether {store} definitely does not write any of the bytes read by {load}.
+// This requires both offsets to be constant, e.g. a store to an array element
+// with a computed index could write any element.
+bool Disjoint(Node* store, Node* load) {
+  IntPtrMatcher store_offset(NodeProperties::GetValueInput(store, 1));
+  IntPtrMatcher load_offset(NodeProperties::GetValueInput(load, 1));
+  if (!store_offset.HasResolvedValue() || !load_offset.HasResolvedValue()) {
+    return false;
+  }
+  int store_size = ElementSizeInBytes(
+      ObjectAccessOf(store->op()).machine_type.representation());
+  int load_size = ElementSizeInBytes(
+      ObjectAccessOf(load->op()).machine_type.representation());
+  return store_offset.ResolvedValue() + store_size <=
+             load_offset.ResolvedValue() ||
+         load_offset.ResolvedValue() + load_size <=
+             store_offset.ResolvedValue();
+}
+
+// Whether loading from a field written by {store} yields the stored value, up
+// to the extension of packed fields (see {ExtendPackedValue}).
+bool CanForward(Node* store, Node* load) {
+  MachineRepresentation stored =
+      ObjectAccessOf(store->op()).machine_type.representation();
+  MachineRepresentation loaded =
+      ObjectAccessOf(load->op()).machine_type.representation();
+  if (IsAnyTagged(stored) && IsAnyTagged(loaded)) return true;
+  return stored == loaded && stored != MachineRepresentation::kBit;
+}
+
+}  // namespace
+
 Reduction WasmEscapeAnalysis::Reduce(Node* node) {
   switch (node->opcode()) {
     case IrOpcode::kAllocateRaw:
@@ -24,27 +82,50 @@ Reduction WasmEscapeAnalysis::ReduceAllocateRaw(Node* node) {
   DCHECK_EQ(node->opcode(), IrOpcode::kAllocateRaw);
   // TODO(manoskouk): Account for phis.
 
-  // Collect all value edges of {node} in this vector.
-  std::vector<Edge> value_edges;
+  // Collect all stores to and loads from {node}. Any other value use lets the
+  // object escape.
+  std::vector<Node*> stores;
+  std::vector<Node*> loads;
   for (Edge edge : node->use_edges()) {
     if (NodeProperties::IsValueEdge(edge)) {
-      if (edge.index() != 0 ||
-          (edge.from()->opcode() != IrOpcode::kStoreToObject &&
-           edge.from()->opcode() != IrOpcode::kInitializeImmutableInObject)) {
+      Node* use = edge.from();
+      if (edge.index() != 0) return NoChange();
+      if (IsStore(use)) {
+        stores.push_back(use);
+      } else if (IsLoad(use)) {
+        loads.push_back(use);
+      } else {
         return NoChange();
       }
-      value_edges.push_back(edge);
     }
   }
 
+  // Every load has to be replaced by a value stored to the same field. Find
+  // all of them before changing the graph, as a single unknown field keeps the
+  // object alive.
+  std::vector<Node*> load_values;
+  load_values.reserve(loads.size());
+  for (Node* load : loads) {
+    Node* value = FindStoredValue(node, load);
+    if (value == nullptr) return NoChange();
+    load_values.push_back(value);
+  }
+
+  // Replace all loads by the forwarded values.
+  for (size_t i = 0; i < loads.size(); i++) {
+    Node* load = loads[i];
+    DCHECK(!load->IsDead());
+    Node* value = ExtendPackedValue(
+        load_values[i], ObjectAccessOf(load->op()).machine_type);
+    ReplaceWithValue(load, value, NodeProperties::GetEffectInput(load),
+                     NodeProperties::GetControlInput(load));
+    load->Kill();
+  }
+
   // Remove all discovered stores from the effect chain.
-  for (Edge edge : value_edges) {
-    DCHECK(NodeProperties::IsValueEdge(edge));
-    DCHECK_EQ(edge.index(), 0);
-    Node* use = edge.from();
+  for (Node* use : stores) {
     DCHECK(!use->IsDead());
-    DCHECK(use->opcode() == IrOpcode::kStoreToObject ||
-           use->opcode() == IrOpcode::kInitializeImmutableInObject);
+    DCHECK(IsStore(use));
     // The value stored by this StoreToObject node might be another allocation
     // which has no more uses. Therefore we have to revisit it. Note that this
     // will not happen automatically: ReplaceWithValue does not trigger revisits
@@ -63,6 +144,54 @@ Reduction WasmEscapeAnalysis::ReduceAllocateRaw(Node* node) {
   return Changed(node);
 }
 
+Node* WasmEscapeAnalysis::FindStoredValue(Node* object, Node* load) {
+  Node* offset = NodeProperties::GetValueInput(load, 1);
+  // Since {object} does not escape, only stores to {object} itself can write
+  // its fields. Walk the effect chain back to the closest one that might write
+  // the loaded field.
+  Node* effect = NodeProperties::GetEffectInput(load);
+  for (int i = 0; i < kMaxEffectChainWalk; i++) {
+    if (effect == object) return nullptr;  // Uninitialized field.
+    if (IsStore(effect) &&
+        NodeProperties::GetValueInput(effect, 0) == object) {
+      if (SameOffset(NodeProperties::GetValueInput(effect, 1), offset)) {
+        if (!CanForward(effect, load)) return nullptr;
+        return NodeProperties::GetValueInput(effect, 2);
+      }
+      // A store which might write the loaded field hides the stored values
+      // further up the effect chain.
+      if (!Disjoint(effect, load)) return nullptr;
+    }
+    // Stores on different paths into an effect phi would have to be merged
+    // with a value phi, which is not supported.
+    if (effect->op()->EffectInputCount() != 1) return nullptr;
+    effect = NodeProperties::GetEffectInput(effect);
+  }
+  return nullptr;
+}
+
+Node* WasmEscapeAnalysis::ExtendPackedValue(Node* value, MachineType type) {
+  // Loads of packed fields sign- or zero-extend the loaded bits to a word32,
+  // whereas the stored value can have arbitrary upper bits.
+  MachineOperatorBuilder* machine = mcgraph_->machine();
+  switch (type.representation()) {
+    case MachineRepresentation::kWord8:
+      return type.IsSigned()
+                 ? mcgraph_->graph()->NewNode(
+                       machine->SignExtendWord8ToInt32(), value)
+                 : mcgraph_->graph()->NewNode(machine->Word32And(), value,
+                                              mcgraph_->Int32Constant(0xFF));
+    case MachineRepresentation::kWord16:
+      return type.IsSigned()
+                 ? mcgraph_->graph()->NewNode(
+                       machine->SignExtendWord16ToInt32(), value)
+                 : mcgraph_->graph()->NewNode(machine->Word32And(), value,
+                                              mcgraph_->Int32Constant(0xFFFF));
+    default:
+      return value;
+  }
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -9,6 +9,7 @@
 #ifndef V8_COMPILER_WASM_ESCAPE_ANALYSIS_H_
 #define V8_COMPILER_WASM_ESCAPE_ANALYSIS_H_
 
+#include "src/codegen/machine-type.h"
 #include "src/compiler/graph-reducer.h"
 
 namespace v8 {
@@ -17,7 +18,9 @@ namespace compiler {
 
 class MachineGraph;
 
-// Eliminate allocated objects with no uses other than as store targets.
+// Eliminate allocated objects with no uses other than as store targets, or as
+// targets of loads whose value can be found on the effect chain (scalar
+// replacement).
 // Future work: Also exclude phis and renamings from uses.
 class WasmEscapeAnalysis final : public AdvancedReducer {
  public:
@@ -30,6 +33,11 @@ class WasmEscapeAnalysis final : public AdvancedReducer {
 
  private:
   Reduction ReduceAllocateRaw(Node* call);
+  // Returns the value stored to the field of {object} read by {load}, or
+  // nullptr if it cannot be determined.
+  Node* FindStoredValue(Node* object, Node* load);
+  // Returns what a load of {type} yields for the stored {value}.
+  Node* ExtendPackedValue(Node* value, MachineType type);
   MachineGraph* const mcgraph_;
 };
 
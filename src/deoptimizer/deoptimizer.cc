@@ -1488,6 +1488,13 @@ TranslatedValue Deoptimizer::TranslatedValueForWasmReturnKind(
         return TranslatedValue::NewDouble(
             &translated_state_,
             input_->GetDoubleRegister(wasm::kFpReturnRegisters[0].code()));
+      case wasm::kRef:
+      case wasm::kRefNull:
+        // Function references are never returned to inlined JS-to-Wasm calls
+        // (see JSCallReducer), so the reference is already a JS value.
+        return TranslatedValue::NewTagged(
+            &translated_state_,
+            Object(input_->GetRegister(kReturnRegister0.code())));
       default:
         UNREACHABLE();
     }
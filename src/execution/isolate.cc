@@ -73,6 +73,7 @@
 #include "src/init/setup-isolate.h"
 #include "src/init/v8.h"
 #include "src/interpreter/interpreter.h"
+#include "src/interpreter/shared-bytecode-table.h"
 #include "src/libsampler/sampler.h"
 #include "src/logging/counters.h"
 #include "src/logging/log.h"
@@ -3586,6 +3587,9 @@ void Isolate::Deinit() {
   BackingStore::RemoveSharedWasmMemoryObjects(this);
 #endif  // V8_ENABLE_WEBASSEMBLY
 
+  // The tiering sampler requests interrupts on this isolate.
+  if (tiering_manager_ != nullptr) tiering_manager_->StopSamplingThread();
+
   if (concurrent_recompilation_enabled()) {
     optimizing_compile_dispatcher_->Stop();
     delete optimizing_compile_dispatcher_;
@@ -3657,6 +3661,7 @@ void Isolate::Deinit() {
   heap_profiler_ = nullptr;
 
   string_table_.reset();
+  shared_bytecode_table_.reset();
 
 #if USE_SIMULATOR
   delete simulator_data_;
@@ -4338,6 +4343,15 @@ bool Isolate::Init(SnapshotData* startup_snapshot_data,
     string_forwarding_table_ = shared_heap_isolate()->string_forwarding_table_;
   }
 
+  if (v8_flags.shared_bytecode) {
+    if (is_shared_heap_isolate()) {
+      shared_bytecode_table_ =
+          std::make_shared<interpreter::SharedBytecodeTable>();
+    } else if (has_shared_heap()) {
+      shared_bytecode_table_ = shared_heap_isolate()->shared_bytecode_table_;
+    }
+  }
+
   if (V8_SHORT_BUILTIN_CALLS_BOOL && v8_flags.short_builtin_calls) {
 #if defined(V8_OS_ANDROID)
     // On Android, the check is not operative to detect memory, and re-embedded
@@ -158,6 +158,7 @@ class BaselineBatchCompiler;
 
 namespace interpreter {
 class Interpreter;
+class SharedBytecodeTable;
 }  // namespace interpreter
 
 namespace compiler {
@@ -750,6 +751,11 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
   StringForwardingTable* string_forwarding_table() const {
     return string_forwarding_table_.get();
   }
+  // The bytecode table shared with all isolates using the same shared heap, or
+  // nullptr without --shared-bytecode.
+  interpreter::SharedBytecodeTable* shared_bytecode_table() const {
+    return shared_bytecode_table_.get();
+  }
 
   Address get_address_from_id(IsolateAddressId id);
 
@@ -2196,6 +2202,7 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
   std::shared_ptr<ReadOnlyArtifacts> artifacts_;
   std::shared_ptr<StringTable> string_table_;
   std::shared_ptr<StringForwardingTable> string_forwarding_table_;
+  std::shared_ptr<interpreter::SharedBytecodeTable> shared_bytecode_table_;
 
   const int id_;
   EntryStackItem* entry_stack_ = nullptr;
@@ -64,6 +64,14 @@ class V8_EXPORT_PRIVATE LocalIsolate final : private HiddenLocalFactory {
   inline Handle<Object> root_handle(RootIndex index) const;
 
   StringTable* string_table() const { return isolate_->string_table(); }
+  interpreter::SharedBytecodeTable* shared_bytecode_table() const {
+    return isolate_->shared_bytecode_table();
+  }
+  // The table is immutable once the isolate is set up, so it can be read from
+  // any thread.
+  ExternalReferenceTable* external_reference_table() const {
+    return isolate_->external_reference_table();
+  }
   base::SharedMutex* internalized_string_access() {
     return isolate_->internalized_string_access();
   }
@@ -0,0 +1,393 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/execution/pgo.h"
+
+#include <algorithm>
+
+#include "src/base/functional.h"
+#include "src/base/platform/platform.h"
+#include "src/base/platform/wrappers.h"
+#include "src/objects/allocation-site-inl.h"
+#include "src/objects/descriptor-array-inl.h"
+#include "src/objects/feedback-vector-inl.h"
+#include "src/objects/js-function-inl.h"
+#include "src/objects/map-inl.h"
+#include "src/objects/script-inl.h"
+#include "src/objects/shared-function-info-inl.h"
+#include "src/objects/string-inl.h"
+#include "src/strings/string-hasher-inl.h"
+#include "src/utils/utils.h"
+
+namespace v8::internal {
+
+namespace {
+
+// "JPGO", followed by the format version.
+constexpr uint32_t kMagic = 0x4f47504a;
+constexpr uint32_t kVersion = 1;
+
+constexpr uint8_t kTieredUpToMaglev = 1;
+constexpr uint8_t kTieredUpToTurbofan = 2;
+
+// Call targets without a script are identified by their builtin id.
+constexpr uint64_t kBuiltinCallTargetTag = uint64_t{1} << 63;
+
+class ProfileWriter {
+ public:
+  void WriteU8(uint8_t value) { buffer_.push_back(value); }
+  void WriteU32(uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+      buffer_.push_back(static_cast<uint8_t>(value >> shift));
+    }
+  }
+  void WriteU64(uint64_t value) {
+    WriteU32(static_cast<uint32_t>(value >> 32));
+    WriteU32(static_cast<uint32_t>(value));
+  }
+
+  std::vector<uint8_t> Finish() { return std::move(buffer_); }
+
+ private:
+  std::vector<uint8_t> buffer_;
+};
+
+// Reads from a profile of unknown origin; any read past the end of the data
+// makes the reader fail, and returns 0.
+class ProfileReader {
+ public:
+  explicit ProfileReader(base::Vector<const uint8_t> data) : data_(data) {}
+
+  bool failed() const { return failed_; }
+  bool at_end() const { return pos_ == data_.size(); }
+  size_t remaining() const { return data_.size() - pos_; }
+
+  uint8_t ReadU8() {
+    if (!Check(1)) return 0;
+    return data_[pos_++];
+  }
+  uint32_t ReadU32() {
+    if (!Check(kUInt32Size)) return 0;
+    uint32_t value = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+      value |= static_cast<uint32_t>(data_[pos_++]) << shift;
+    }
+    return value;
+  }
+  uint64_t ReadU64() {
+    uint64_t value = static_cast<uint64_t>(ReadU32()) << 32;
+    return value | ReadU32();
+  }
+
+  void Fail() { failed_ = true; }
+
+ private:
+  bool Check(size_t size) {
+    if (failed_ || remaining() < size) failed_ = true;
+    return !failed_;
+  }
+
+  base::Vector<const uint8_t> data_;
+  size_t pos_ = 0;
+  bool failed_ = false;
+};
+
+// Hashes {string} without the isolate's random hash seed.
+uint32_t SeedlessHash(String string) {
+  uint32_t running_hash = static_cast<uint32_t>(string.length());
+  StringCharacterStream stream(string);
+  while (stream.HasMore()) {
+    running_hash = StringHasher::AddCharacterCore(running_hash,
+                                                  stream.GetNext());
+  }
+  return StringHasher::GetHashCore(running_hash);
+}
+
+// A structural descriptor of {map}, which is stable across runs (unlike the
+// map's address).
+uint32_t MapDescriptor(Map map) {
+  size_t hash =
+      base::hash_combine(static_cast<size_t>(map.instance_type()),
+                         static_cast<size_t>(map.elements_kind()));
+  hash = base::hash_combine(hash, static_cast<size_t>(map.instance_size()));
+  hash = base::hash_combine(hash, static_cast<size_t>(map.is_dictionary_map()));
+  DescriptorArray descriptors = map.instance_descriptors();
+  for (InternalIndex i : map.IterateOwnDescriptors()) {
+    Name key = descriptors.GetKey(i);
+    hash = base::hash_combine(
+        hash, key.IsString() ? SeedlessHash(String::cast(key)) : size_t{0});
+    hash = base::hash_combine(
+        hash, static_cast<size_t>(descriptors.GetDetails(i).AsSmi().value()));
+  }
+  return static_cast<uint32_t>(hash);
+}
+
+bool HasReceiverMaps(FeedbackSlotKind kind) {
+  return IsLoadICKind(kind) || IsSetNamedICKind(kind) ||
+         IsKeyedLoadICKind(kind) || IsKeyedStoreICKind(kind) ||
+         IsDefineNamedOwnICKind(kind) ||
+         IsDefineKeyedOwnPropertyInLiteralKind(kind) ||
+         IsStoreInArrayLiteralICKind(kind) || IsKeyedHasICKind(kind) ||
+         IsDefineKeyedOwnICKind(kind);
+}
+
+}  // namespace
+
+base::Optional<JSProfileInformation::FunctionKey> JSProfileInformation::KeyFor(
+    SharedFunctionInfo shared) {
+  DisallowGarbageCollection no_gc;
+  if (!shared.script().IsScript()) return {};
+  Script script = Script::cast(shared.script());
+  if (!script.source().IsString()) return {};
+
+  auto it = script_hashes_.find(script.id());
+  if (it == script_hashes_.end()) {
+    // Computed once per script.
+    it = script_hashes_
+             .emplace(script.id(), SeedlessHash(String::cast(script.source())))
+             .first;
+  }
+  return (static_cast<FunctionKey>(it->second) << 32) |
+         static_cast<uint32_t>(shared.StartPosition());
+}
+
+uint64_t JSProfileInformation::CallTargetKey(MaybeObject feedback) {
+  HeapObject target;
+  if (!feedback->GetHeapObjectIfWeak(&target) || !target.IsJSFunction()) {
+    return 0;
+  }
+  SharedFunctionInfo shared = JSFunction::cast(target).shared();
+  if (shared.HasBuiltinId()) {
+    return kBuiltinCallTargetTag | static_cast<uint64_t>(shared.builtin_id());
+  }
+  return KeyFor(shared).value_or(0);
+}
+
+JSProfileInformation::SlotFeedback JSProfileInformation::CollectSlotFeedback(
+    FeedbackVector vector, FeedbackSlot slot, FeedbackSlotKind kind) {
+  FeedbackNexus nexus(vector, slot);
+  SlotFeedback feedback{static_cast<uint32_t>(slot.ToInt()),
+                        kind,
+                        nexus.ic_state(),
+                        0,
+                        0,
+                        {}};
+  if (feedback.ic_state == InlineCacheState::UNINITIALIZED) return feedback;
+
+  switch (kind) {
+    case FeedbackSlotKind::kBinaryOp:
+      feedback.hint =
+          static_cast<uint32_t>(nexus.GetBinaryOperationFeedback());
+      break;
+    case FeedbackSlotKind::kCompareOp:
+      feedback.hint =
+          static_cast<uint32_t>(nexus.GetCompareOperationFeedback());
+      break;
+    case FeedbackSlotKind::kForIn:
+      feedback.hint = static_cast<uint32_t>(nexus.GetForInFeedback());
+      break;
+    case FeedbackSlotKind::kLiteral: {
+      HeapObject site;
+      if (nexus.GetFeedback()->GetHeapObjectIfStrong(&site) &&
+          site.IsAllocationSite()) {
+        feedback.hint = static_cast<uint32_t>(
+                            AllocationSite::cast(site).GetElementsKind()) +
+                        1;
+      }
+      break;
+    }
+    case FeedbackSlotKind::kCall:
+      feedback.call_target = CallTargetKey(nexus.GetFeedback());
+      break;
+    default:
+      if (HasReceiverMaps(kind)) {
+        for (FeedbackIterator it(&nexus); !it.done(); it.Advance()) {
+          feedback.maps.push_back(MapDescriptor(it.map()));
+        }
+        std::sort(feedback.maps.begin(), feedback.maps.end());
+      }
+      break;
+  }
+  return feedback;
+}
+
+void JSProfileInformation::RecordOptimization(JSFunction function,
+                                              CodeKind code_kind) {
+  DCHECK(CodeKindIsOptimizedJSFunction(code_kind));
+  base::Optional<FunctionKey> key = KeyFor(function.shared());
+  if (!key.has_value()) return;
+  FunctionProfile& profile = functions_[*key];
+  // Only the highest tier (and the feedback it was last reached with) is kept.
+  if (profile.tier == CodeKind::TURBOFAN && code_kind != CodeKind::TURBOFAN) {
+    return;
+  }
+  profile.tier = code_kind;
+  profile.feedback.clear();
+
+  // Polymorphic feedback is iterated through handles.
+  HandleScope scope(function.GetIsolate());
+  FeedbackVector vector = function.feedback_vector();
+  profile.slot_count = static_cast<uint32_t>(vector.length());
+  FeedbackMetadataIterator iter(vector.metadata());
+  while (iter.HasNext()) {
+    FeedbackSlot slot = iter.Next();
+    SlotFeedback feedback = CollectSlotFeedback(vector, slot, iter.kind());
+    if (feedback.ic_state == InlineCacheState::UNINITIALIZED) continue;
+    profile.feedback.push_back(std::move(feedback));
+  }
+}
+
+base::Optional<CodeKind> JSProfileInformation::ProfiledTier(
+    SharedFunctionInfo shared) {
+  if (functions_.empty()) return {};
+  base::Optional<FunctionKey> key = KeyFor(shared);
+  if (!key.has_value()) return {};
+  auto it = functions_.find(*key);
+  if (it == functions_.end()) return {};
+  return it->second.tier;
+}
+
+bool JSProfileInformation::HasProfiledTurbofanFeedback(JSFunction function) {
+  if (functions_.empty() || !function.has_feedback_vector()) return false;
+  base::Optional<FunctionKey> key = KeyFor(function.shared());
+  if (!key.has_value()) return false;
+  auto it = functions_.find(*key);
+  if (it == functions_.end()) return false;
+  const FunctionProfile& profile = it->second;
+  if (profile.tier != CodeKind::TURBOFAN) return false;
+
+  HandleScope scope(function.GetIsolate());
+  FeedbackVector vector = function.feedback_vector();
+  // A different number of slots means that the function has changed.
+  if (profile.slot_count != static_cast<uint32_t>(vector.length())) {
+    return false;
+  }
+  for (const SlotFeedback& recorded : profile.feedback) {
+    FeedbackSlot slot(recorded.slot);
+    FeedbackSlotKind kind = vector.GetKind(slot);
+    if (kind != recorded.kind) return false;
+    if (CollectSlotFeedback(vector, slot, kind) != recorded) return false;
+  }
+  return true;
+}
+
+std::vector<uint8_t> JSProfileInformation::Serialize() const {
+  ProfileWriter writer;
+  writer.WriteU32(kMagic);
+  writer.WriteU32(kVersion);
+  writer.WriteU32(static_cast<uint32_t>(functions_.size()));
+  for (const auto& [key, profile] : functions_) {
+    writer.WriteU64(key);
+    writer.WriteU8(profile.tier == CodeKind::TURBOFAN ? kTieredUpToTurbofan
+                                                      : kTieredUpToMaglev);
+    writer.WriteU32(profile.slot_count);
+    writer.WriteU32(static_cast<uint32_t>(profile.feedback.size()));
+    for (const SlotFeedback& feedback : profile.feedback) {
+      writer.WriteU32(feedback.slot);
+      writer.WriteU8(static_cast<uint8_t>(feedback.kind));
+      writer.WriteU8(static_cast<uint8_t>(feedback.ic_state));
+      writer.WriteU32(feedback.hint);
+      writer.WriteU64(feedback.call_target);
+      writer.WriteU32(static_cast<uint32_t>(feedback.maps.size()));
+      for (uint32_t map : feedback.maps) writer.WriteU32(map);
+    }
+  }
+  return writer.Finish();
+}
+
+// static
+std::unique_ptr<JSProfileInformation> JSProfileInformation::Deserialize(
+    base::Vector<const uint8_t> data) {
+  ProfileReader reader(data);
+  if (reader.ReadU32() != kMagic || reader.ReadU32() != kVersion) return {};
+
+  auto result = std::make_unique<JSProfileInformation>();
+  uint32_t num_functions = reader.ReadU32();
+  for (uint32_t i = 0; i < num_functions && !reader.failed(); ++i) {
+    FunctionKey key = reader.ReadU64();
+    FunctionProfile profile;
+    uint8_t tier = reader.ReadU8();
+    if (tier != kTieredUpToMaglev && tier != kTieredUpToTurbofan) {
+      reader.Fail();
+    }
+    profile.tier =
+        tier == kTieredUpToTurbofan ? CodeKind::TURBOFAN : CodeKind::MAGLEV;
+    profile.slot_count = reader.ReadU32();
+    uint32_t num_slots = reader.ReadU32();
+    // Don't trust the count for reserving memory.
+    for (uint32_t j = 0; j < num_slots && !reader.failed(); ++j) {
+      SlotFeedback feedback;
+      feedback.slot = reader.ReadU32();
+      uint8_t kind = reader.ReadU8();
+      uint8_t ic_state = reader.ReadU8();
+      if (feedback.slot >= profile.slot_count || kind == 0 ||
+          kind >= kFeedbackSlotKindCount ||
+          ic_state > static_cast<uint8_t>(InlineCacheState::GENERIC)) {
+        reader.Fail();
+      }
+      feedback.kind = static_cast<FeedbackSlotKind>(kind);
+      feedback.ic_state = static_cast<InlineCacheState>(ic_state);
+      feedback.hint = reader.ReadU32();
+      feedback.call_target = reader.ReadU64();
+      uint32_t num_maps = reader.ReadU32();
+      if (num_maps > reader.remaining() / kUInt32Size) reader.Fail();
+      for (uint32_t k = 0; k < num_maps && !reader.failed(); ++k) {
+        feedback.maps.push_back(reader.ReadU32());
+      }
+      profile.feedback.push_back(std::move(feedback));
+    }
+    if (!result->functions_.emplace(key, std::move(profile)).second) {
+      // Duplicate key.
+      reader.Fail();
+    }
+  }
+  if (reader.failed() || !reader.at_end()) return {};
+  return result;
+}
+
+void JSProfileInformation::DumpToFile(const char* filename) const {
+  std::vector<uint8_t> profile_data = Serialize();
+  PrintF("Dumping JS PGO data to file '%s' (%zu bytes)\n", filename,
+         profile_data.size());
+  if (FILE* file = base::OS::FOpen(filename, "wb")) {
+    size_t written = fwrite(profile_data.data(), 1, profile_data.size(), file);
+    CHECK_EQ(profile_data.size(), written);
+    base::Fclose(file);
+  }
+}
+
+// static
+std::unique_ptr<JSProfileInformation> JSProfileInformation::LoadFromFile(
+    const char* filename) {
+  FILE* file = base::OS::FOpen(filename, "rb");
+  if (!file) {
+    PrintF("No JS PGO data found: Cannot open file '%s'\n", filename);
+    return {};
+  }
+
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  rewind(file);
+  if (size < 0) {
+    base::Fclose(file);
+    PrintF("Cannot read JS PGO data from file '%s'\n", filename);
+    return {};
+  }
+
+  PrintF("Loading JS PGO data from file '%s' (%ld bytes)\n", filename, size);
+  std::vector<uint8_t> profile_data(static_cast<size_t>(size));
+  size_t read = fread(profile_data.data(), 1, profile_data.size(), file);
+  base::Fclose(file);
+
+  std::unique_ptr<JSProfileInformation> profile;
+  if (read == profile_data.size()) {
+    profile = Deserialize(base::VectorOf(profile_data));
+  }
+  if (!profile) {
+    PrintF("Ignoring invalid JS PGO data in file '%s'\n", filename);
+  }
+  return profile;
+}
+
+}  // namespace v8::internal
@@ -0,0 +1,112 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_EXECUTION_PGO_H_
+#define V8_EXECUTION_PGO_H_
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "src/base/optional.h"
+#include "src/base/vector.h"
+#include "src/common/globals.h"
+#include "src/objects/code-kind.h"
+#include "src/objects/feedback-vector.h"
+
+namespace v8::internal {
+
+class JSFunction;
+class Map;
+class SharedFunctionInfo;
+
+// Profile-guided optimization for JavaScript, the counterpart of
+// {wasm::ProfileInformation}. A profile records, for every function that was
+// optimized, the tier it was optimized to and the feedback it was optimized
+// with, so that a later run of the same scripts can optimize it as soon as its
+// feedback has warmed up to the same state again.
+//
+// Functions are identified by a hash of their script's source and their start
+// position, which (unlike script ids, or the isolate's string hashes) are
+// stable across runs. Heap objects in the feedback are persisted as stable
+// structural descriptors instead:
+// - receiver maps by a seed-independent hash of their instance type, elements
+//   kind, instance size and own property names and details,
+// - call targets by the key of their function (or their builtin id),
+// - literal boilerplates by their elements kind.
+class V8_EXPORT_PRIVATE JSProfileInformation {
+ public:
+  JSProfileInformation() = default;
+  JSProfileInformation(const JSProfileInformation&) = delete;
+  JSProfileInformation& operator=(const JSProfileInformation&) = delete;
+
+  // Records that {function} has been marked for optimization to {code_kind},
+  // together with its current feedback.
+  void RecordOptimization(JSFunction function, CodeKind code_kind);
+
+  // Returns the highest tier {shared} was optimized to in the profile.
+  base::Optional<CodeKind> ProfiledTier(SharedFunctionInfo shared);
+
+  // Returns whether {function} was optimized to Turbofan in the profile, with
+  // feedback that is structurally the same as its current feedback.
+  bool HasProfiledTurbofanFeedback(JSFunction function);
+
+  std::vector<uint8_t> Serialize() const;
+  // Returns null if {data} is not a valid profile.
+  V8_WARN_UNUSED_RESULT static std::unique_ptr<JSProfileInformation>
+  Deserialize(base::Vector<const uint8_t> data);
+
+  void DumpToFile(const char* filename) const;
+  V8_WARN_UNUSED_RESULT static std::unique_ptr<JSProfileInformation>
+  LoadFromFile(const char* filename);
+
+ private:
+  // The script hash in the upper, and the start position in the lower half.
+  using FunctionKey = uint64_t;
+
+  struct SlotFeedback {
+    uint32_t slot;
+    FeedbackSlotKind kind;
+    InlineCacheState ic_state;
+    // The operation hint of binary operation, compare and for-in slots, or the
+    // elements kind (plus one) of the allocation site of literal slots.
+    uint32_t hint;
+    // The key of the monomorphic call target of call slots, see
+    // {CallTargetKey}.
+    uint64_t call_target;
+    // The structural descriptors of the receiver maps, sorted.
+    std::vector<uint32_t> maps;
+
+    bool operator==(const SlotFeedback& other) const {
+      return slot == other.slot && kind == other.kind &&
+             ic_state == other.ic_state && hint == other.hint &&
+             call_target == other.call_target && maps == other.maps;
+    }
+    bool operator!=(const SlotFeedback& other) const {
+      return !(*this == other);
+    }
+  };
+
+  struct FunctionProfile {
+    CodeKind tier;
+    uint32_t slot_count;
+    // The slots that were initialized at the time of optimization.
+    std::vector<SlotFeedback> feedback;
+  };
+
+  base::Optional<FunctionKey> KeyFor(SharedFunctionInfo shared);
+  uint64_t CallTargetKey(MaybeObject feedback);
+  SlotFeedback CollectSlotFeedback(FeedbackVector vector, FeedbackSlot slot,
+                                   FeedbackSlotKind kind);
+
+  // Ordered, to generate deterministic profiles.
+  std::map<FunctionKey, FunctionProfile> functions_;
+  // Source hashes, by script id.
+  std::unordered_map<int, uint32_t> script_hashes_;
+};
+
+}  // namespace v8::internal
+
+#endif  // V8_EXECUTION_PGO_H_
@@ -9,6 +9,7 @@
 #include "src/execution/interrupts-scope.h"
 #include "src/execution/isolate.h"
 #include "src/execution/simulator.h"
+#include "src/execution/tiering-manager.h"
 #include "src/logging/counters.h"
 #include "src/objects/backing-store.h"
 #include "src/roots/roots-inl.h"
@@ -342,6 +343,12 @@ Object StackGuard::HandleInterrupts() {
   }
 #endif  // V8_ENABLE_MAGLEV
 
+  if (TestAndClear(&interrupt_flags, TIERING_SAMPLE)) {
+    TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+                 "V8.TieringSample");
+    isolate_->tiering_manager()->OnSample();
+  }
+
   if (TestAndClear(&interrupt_flags, API_INTERRUPT)) {
     TRACE_EVENT0("v8.execute", "V8.InvokeApiInterruptCallbacks");
     // Callbacks must be invoked outside of ExecutionAccess lock.
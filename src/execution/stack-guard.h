@@ -56,7 +56,8 @@ class V8_EXPORT_PRIVATE V8_NODISCARD StackGuard final {
   V(LOG_WASM_CODE, LogWasmCode, 7)                                \
   V(WASM_CODE_GC, WasmCodeGC, 8)                                  \
   V(INSTALL_MAGLEV_CODE, InstallMaglevCode, 9)                    \
-  V(GLOBAL_SAFEPOINT, GlobalSafepoint, 10)
+  V(GLOBAL_SAFEPOINT, GlobalSafepoint, 10)                        \
+  V(TIERING_SAMPLE, TieringSample, 11)
 
 #define V(NAME, Name, id)                                    \
   inline bool Check##Name() { return CheckInterrupt(NAME); } \
@@ -4,7 +4,10 @@
 
 #include "src/execution/tiering-manager.h"
 
+#include <atomic>
+
 #include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
 #include "src/baseline/baseline-batch-compiler.h"
 #include "src/baseline/baseline.h"
 #include "src/codegen/assembler.h"
@@ -15,6 +18,7 @@
 #include "src/diagnostics/code-tracer.h"
 #include "src/execution/execution.h"
 #include "src/execution/frames-inl.h"
+#include "src/execution/pgo.h"
 #include "src/flags/flags.h"
 #include "src/handles/global-handles.h"
 #include "src/init/bootstrapper.h"
@@ -29,7 +33,9 @@ namespace internal {
 #define OPTIMIZATION_REASON_LIST(V)   \
   V(DoNotOptimize, "do not optimize") \
   V(HotAndStable, "hot and stable")   \
-  V(SmallFunction, "small function")
+  V(Profiled, "profile-guided")       \
+  V(SmallFunction, "small function")  \
+  V(StuckInLoop, "stuck in loop")
 
 enum class OptimizationReason : uint8_t {
 #define OPTIMIZATION_REASON_CONSTANTS(Constant, message) k##Constant,
@@ -65,10 +71,18 @@ class OptimizationDecision {
     return {OptimizationReason::kHotAndStable, CodeKind::TURBOFAN,
             ConcurrencyMode::kConcurrent};
   }
+  static constexpr OptimizationDecision TurbofanProfiled() {
+    return {OptimizationReason::kProfiled, CodeKind::TURBOFAN,
+            ConcurrencyMode::kConcurrent};
+  }
   static constexpr OptimizationDecision TurbofanSmallFunction() {
     return {OptimizationReason::kSmallFunction, CodeKind::TURBOFAN,
             ConcurrencyMode::kConcurrent};
   }
+  static constexpr OptimizationDecision TurbofanStuckInLoop() {
+    return {OptimizationReason::kStuckInLoop, CodeKind::TURBOFAN,
+            ConcurrencyMode::kConcurrent};
+  }
   static constexpr OptimizationDecision DoNotOptimize() {
     return {OptimizationReason::kDoNotOptimize,
             // These values don't matter but we have to pass something.
@@ -138,9 +152,69 @@ void TraceManualRecompile(JSFunction function, CodeKind code_kind,
   }
 }
 
+// Periodically requests a stack interrupt, on which the main thread calls
+// {TieringManager::OnSample}. The samples are taken by the main thread itself,
+// since walking its stack from a signal handler (as the CPU profiler does)
+// can't safely access the functions' feedback vectors.
+//
+// Only one sample is requested at a time: the thread waits for it to be taken
+// before starting the next interval. Stack interrupts are only handled while
+// the isolate runs JavaScript, so the thread stays parked (without waking up)
+// while the isolate is idle.
+class TieringManager::SamplingThread final : public base::Thread {
+ public:
+  explicit SamplingThread(Isolate* isolate)
+      : Thread(Options("v8:TieringSampler")), isolate_(isolate) {}
+
+  void Run() override {
+    const base::TimeDelta interval =
+        base::TimeDelta::FromMicroseconds(v8_flags.tiering_sampling_interval);
+    while (!stop_semaphore_.WaitFor(interval)) {
+      isolate_->stack_guard()->RequestTieringSample();
+      sample_taken_semaphore_.Wait();
+      if (stopped_.load(std::memory_order_relaxed)) return;
+    }
+  }
+
+  // Called on the main thread when the requested sample is taken.
+  void NotifySampleTaken() { sample_taken_semaphore_.Signal(); }
+
+  void Stop() {
+    stopped_.store(true, std::memory_order_relaxed);
+    stop_semaphore_.Signal();
+    sample_taken_semaphore_.Signal();
+    Join();
+  }
+
+ private:
+  Isolate* const isolate_;
+  std::atomic<bool> stopped_{false};
+  base::Semaphore stop_semaphore_{0};
+  base::Semaphore sample_taken_semaphore_{0};
+};
+
+TieringManager::TieringManager(Isolate* isolate) : isolate_(isolate) {
+  if (V8_UNLIKELY(v8_flags.experimental_js_pgo_from_file)) {
+    loaded_profile_ = JSProfileInformation::LoadFromFile(v8_flags.js_pgo_file);
+  }
+  if (V8_UNLIKELY(v8_flags.experimental_js_pgo_to_file)) {
+    recorded_profile_ = std::make_unique<JSProfileInformation>();
+  }
+}
+
+TieringManager::~TieringManager() {
+  StopSamplingThread();
+  if (V8_UNLIKELY(recorded_profile_)) {
+    recorded_profile_->DumpToFile(v8_flags.js_pgo_file);
+  }
+}
+
 void TieringManager::Optimize(JSFunction function, OptimizationDecision d) {
   DCHECK(d.should_optimize());
   TraceRecompile(isolate_, function, d);
+  if (V8_UNLIKELY(recorded_profile_)) {
+    recorded_profile_->RecordOptimization(function, d.code_kind);
+  }
   function.MarkForOptimization(isolate_, d.code_kind, d.concurrency_mode);
 }
 
@@ -274,7 +348,8 @@ void TieringManager::RequestOsrAtNextOpportunity(JSFunction function) {
 }
 
 void TieringManager::MaybeOptimizeFrame(JSFunction function,
-                                        CodeKind calling_code_kind) {
+                                        CodeKind calling_code_kind,
+                                        bool from_jump_loop) {
   const TieringState tiering_state = function.feedback_vector().tiering_state();
   const TieringState osr_tiering_state =
       function.feedback_vector().osr_tiering_state();
@@ -332,6 +407,17 @@ void TieringManager::MaybeOptimizeFrame(JSFunction function,
     bool is_marked_for_maglev_optimization =
         IsRequestMaglev(tiering_state) ||
         function.HasAvailableCodeKind(CodeKind::MAGLEV);
+    if (v8_flags.osr_past_maglev && from_jump_loop &&
+        function.HasAvailableCodeKind(CodeKind::MAGLEV) &&
+        CanOptimizeWithTurbofan(function)) {
+      // Maglev code is ready, yet this frame keeps ticking on a loop back
+      // edge: it is stuck in a long-running loop, and nothing short of OSR will
+      // speed it up. Don't wait for the Turbofan ticks to accumulate, OSR right
+      // away. (Other ticks, e.g. on return, are no evidence of a loop.)
+      Optimize(function, OptimizationDecision::TurbofanStuckInLoop());
+      TryRequestOsrAtNextOpportunity(isolate_, function);
+      return;
+    }
     if (is_marked_for_maglev_optimization) {
       d = ShouldOptimize(function, CodeKind::MAGLEV);
     }
@@ -340,8 +426,23 @@ void TieringManager::MaybeOptimizeFrame(JSFunction function,
   if (d.should_optimize()) Optimize(function, d);
 }
 
+bool TieringManager::CanOptimizeWithTurbofan(JSFunction function) {
+  return v8_flags.turbofan &&
+         function.shared().PassesFilter(v8_flags.turbo_filter) &&
+         function.shared().GetBytecodeArray(isolate_).length() <=
+             v8_flags.max_optimized_bytecode_size;
+}
+
 OptimizationDecision TieringManager::ShouldOptimize(
     JSFunction function, CodeKind calling_code_kind) {
+  // Functions that reached Turbofan in a previous run go there directly (also
+  // skipping Maglev) as soon as their feedback matches the profiled feedback.
+  if (V8_UNLIKELY(loaded_profile_) && calling_code_kind != CodeKind::TURBOFAN &&
+      CanOptimizeWithTurbofan(function) &&
+      loaded_profile_->HasProfiledTurbofanFeedback(function)) {
+    return OptimizationDecision::TurbofanProfiled();
+  }
+
   if (TiersUpToMaglev(calling_code_kind) &&
       function.shared().PassesFilter(v8_flags.maglev_filter) &&
       !function.shared(isolate_).maglev_compilation_failed()) {
@@ -387,6 +488,54 @@ OptimizationDecision TieringManager::ShouldOptimize(
   return OptimizationDecision::DoNotOptimize();
 }
 
+void TieringManager::StartSamplingThread() {
+  DCHECK(v8_flags.tiering_sampling);
+  DCHECK(!sampling_thread_);
+  sampling_thread_ = std::make_unique<SamplingThread>(isolate_);
+  CHECK(sampling_thread_->Start());
+}
+
+void TieringManager::StopSamplingThread() {
+  if (!sampling_thread_) return;
+  sampling_thread_->Stop();
+  sampling_thread_.reset();
+}
+
+void TieringManager::OnSample() {
+  DCHECK(v8_flags.tiering_sampling);
+  // Unpark the sampling thread, the next sample is requested after the next
+  // interval.
+  if (sampling_thread_) sampling_thread_->NotifySampleTaken();
+  DisallowGarbageCollection no_gc;
+  JavaScriptFrameIterator it(isolate_);
+  if (it.done()) return;
+  JavaScriptFrame* frame = it.frame();
+  JSFunction function = frame->function();
+  // Feedback vectors (and Sparkplug code) are still allocated on budget
+  // interrupts, since the sampled frame is not necessarily the one running
+  // out of budget.
+  if (!function.has_feedback_vector()) return;
+  if (V8_UNLIKELY(!isolate_->use_optimizer())) return;
+
+  CodeKind code_kind;
+  if (frame->is_turbofan()) {
+    code_kind = CodeKind::TURBOFAN;
+  } else if (frame->is_maglev()) {
+    code_kind = CodeKind::MAGLEV;
+  } else if (frame->is_baseline()) {
+    code_kind = CodeKind::BASELINE;
+  } else if (frame->is_interpreted()) {
+    code_kind = CodeKind::INTERPRETED_FUNCTION;
+  } else {
+    return;
+  }
+
+  OnInterruptTickScope scope(this);
+  function.feedback_vector().SaturatingIncrementProfilerTicks();
+  // A sample doesn't tell whether the frame is in a loop.
+  MaybeOptimizeFrame(function, code_kind, /* from_jump_loop */ false);
+}
+
 void TieringManager::NotifyICChanged(FeedbackVector vector) {
   if (v8_flags.global_ic_updated_flag) {
     any_ic_changed_ = true;
@@ -415,7 +564,7 @@ TieringManager::OnInterruptTickScope::~OnInterruptTickScope() {
 }
 
 void TieringManager::OnInterruptTick(Handle<JSFunction> function,
-                                     CodeKind code_kind) {
+                                     CodeKind code_kind, bool from_jump_loop) {
   IsCompiledScope is_compiled_scope(
       function->shared().is_compiled_scope(isolate_));
 
@@ -475,6 +624,15 @@ void TieringManager::OnInterruptTick(Handle<JSFunction> function,
     return;
   }
 
+  // With sampling-based tiering, the interrupt budget only serves to allocate
+  // feedback vectors and to handle stack interrupts (including the samples'),
+  // the tiering decisions are made in {OnSample}.
+  if (V8_UNLIKELY(v8_flags.tiering_sampling)) {
+    if (!sampling_thread_) StartSamplingThread();
+    function->SetInterruptBudget(isolate_);
+    return;
+  }
+
   // --- We've decided to proceed for now. ---
 
   DisallowGarbageCollection no_gc;
@@ -483,7 +641,7 @@ void TieringManager::OnInterruptTick(Handle<JSFunction> function,
 
   function_obj.feedback_vector().SaturatingIncrementProfilerTicks();
 
-  MaybeOptimizeFrame(function_obj, code_kind);
+  MaybeOptimizeFrame(function_obj, code_kind, from_jump_loop);
 
   // Make sure to set the interrupt budget after maybe starting an optimization,
   // so that the interrupt budget size takes into account tiering state.
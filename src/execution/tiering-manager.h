@@ -5,6 +5,8 @@
 #ifndef V8_EXECUTION_TIERING_MANAGER_H_
 #define V8_EXECUTION_TIERING_MANAGER_H_
 
+#include <memory>
+
 #include "src/common/assert-scope.h"
 #include "src/handles/handles.h"
 #include "src/utils/allocation.h"
@@ -15,6 +17,7 @@ namespace internal {
 class BytecodeArray;
 class Isolate;
 class JSFunction;
+class JSProfileInformation;
 class OptimizationDecision;
 enum class CodeKind : uint8_t;
 enum class OptimizationReason : uint8_t;
@@ -24,9 +27,20 @@ void TraceManualRecompile(JSFunction function, CodeKind code_kind,
 
 class TieringManager {
  public:
-  explicit TieringManager(Isolate* isolate) : isolate_(isolate) {}
+  explicit TieringManager(Isolate* isolate);
+  ~TieringManager();
+
+  // {from_jump_loop} is set for ticks on loop back edges, i.e. when the frame
+  // is known to be executing a loop.
+  void OnInterruptTick(Handle<JSFunction> function, CodeKind code_kind,
+                       bool from_jump_loop);
 
-  void OnInterruptTick(Handle<JSFunction> function, CodeKind code_kind);
+  // Called when the interrupt requested by the tiering sampler is handled
+  // (--tiering-sampling). Ticks the function executing in the topmost frame.
+  void OnSample();
+  // Stops the thread requesting the samples, if any. Must be called before the
+  // isolate's stack guard is torn down.
+  void StopSamplingThread();
 
   void NotifyICChanged(FeedbackVector vector);
 
@@ -42,11 +56,14 @@ class TieringManager {
   // Make the decision whether to optimize the given function, and mark it for
   // optimization if the decision was 'yes'.
   // This function is also responsible for bumping the OSR urgency.
-  void MaybeOptimizeFrame(JSFunction function, CodeKind code_kind);
+  void MaybeOptimizeFrame(JSFunction function, CodeKind code_kind,
+                          bool from_jump_loop);
 
   OptimizationDecision ShouldOptimize(JSFunction function, CodeKind code_kind);
+  bool CanOptimizeWithTurbofan(JSFunction function);
   void Optimize(JSFunction function, OptimizationDecision decision);
   void Baseline(JSFunction function, OptimizationReason reason);
+  void StartSamplingThread();
 
   class V8_NODISCARD OnInterruptTickScope final {
    public:
@@ -58,8 +75,15 @@ class TieringManager {
     DisallowGarbageCollection no_gc;
   };
 
+  class SamplingThread;
+
   Isolate* const isolate_;
   bool any_ic_changed_ = false;
+  std::unique_ptr<SamplingThread> sampling_thread_;
+  // Tiering decisions of a previous run (--experimental-js-pgo-from-file).
+  std::unique_ptr<JSProfileInformation> loaded_profile_;
+  // Tiering decisions of this run (--experimental-js-pgo-to-file).
+  std::unique_ptr<JSProfileInformation> recorded_profile_;
 };
 
 }  // namespace internal
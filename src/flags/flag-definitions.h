@@ -360,6 +360,8 @@ DEFINE_NEG_IMPLICATION(enable_third_party_heap, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(enable_third_party_heap, script_streaming)
 DEFINE_NEG_IMPLICATION(enable_third_party_heap,
                        parallel_compile_tasks_for_eager_toplevel)
+DEFINE_NEG_IMPLICATION(enable_third_party_heap,
+                       parallel_compile_tasks_for_eager_inner)
 DEFINE_NEG_IMPLICATION(enable_third_party_heap, use_marking_progress_bar)
 DEFINE_NEG_IMPLICATION(enable_third_party_heap, move_object_start)
 DEFINE_NEG_IMPLICATION(enable_third_party_heap, concurrent_marking)
@@ -637,6 +639,24 @@ DEFINE_BOOL(global_ic_updated_flag, true,
 DEFINE_BOOL(reset_interrupt_on_ic_update, false,
             "On IC change, reset the interrupt budget for just that function.")
 
+// Tiering: sampling.
+DEFINE_BOOL(tiering_sampling, false,
+            "make tier-up decisions based on periodic samples of the executing "
+            "function, instead of on interrupt budget exhaustion")
+DEFINE_INT(tiering_sampling_interval, 1000,
+           "interval between tiering samples, in microseconds")
+
+// Tiering: profile-guided optimization.
+DEFINE_BOOL(experimental_js_pgo_to_file, false,
+            "experimental: dump JS tiering decisions to a local file (for "
+            "testing)")
+DEFINE_BOOL(experimental_js_pgo_from_file, false,
+            "experimental: read JS tiering decisions from a local file and "
+            "tier up profiled functions early (for testing)")
+DEFINE_STRING(js_pgo_file, "profile-js",
+              "file written by --experimental-js-pgo-to-file and read by "
+              "--experimental-js-pgo-from-file")
+
 // Flags for inline caching and feedback vectors.
 DEFINE_BOOL(use_ic, true, "use inline caching")
 DEFINE_BOOL(lazy_feedback_allocation, true, "Allocate feedback vectors lazily")
@@ -727,6 +747,8 @@ DEFINE_STRING(sparkplug_filter, "*", "filter for Sparkplug baseline compiler")
 DEFINE_BOOL(sparkplug_needs_short_builtins, false,
             "only enable Sparkplug baseline compiler when "
             "--short-builtin-calls are also enabled")
+DEFINE_BOOL(code_cache_baseline_code, false,
+            "include Sparkplug code in the code cache")
 DEFINE_INT(baseline_batch_compilation_threshold, 4 * KB,
            "the estimated instruction size of a batch to trigger compilation")
 DEFINE_BOOL(trace_baseline, false, "trace baseline compilation")
@@ -750,6 +772,24 @@ DEFINE_BOOL(
 // forwarding table.
 DEFINE_NEG_IMPLICATION(shared_string_table, always_use_string_forwarding_table)
 
+// Share bytecode of identical functions between Isolates in the shared heap.
+// Only the x64 and ia32 interpreter entries avoid writing the age of shared
+// bytecode.
+#if V8_TARGET_ARCH_X64 || V8_TARGET_ARCH_IA32
+DEFINE_BOOL(shared_bytecode, false,
+            "share identical bytecode between isolates via the shared heap")
+#else
+DEFINE_BOOL_READONLY(
+    shared_bytecode, false,
+    "share identical bytecode between isolates via the shared heap")
+#endif
+DEFINE_IMPLICATION(shared_bytecode, shared_string_table)
+// Shared bytecode can't be modified, so its source positions have to be
+// collected eagerly.
+DEFINE_NEG_IMPLICATION(shared_bytecode, enable_lazy_source_positions)
+DEFINE_INT(shared_bytecode_max_size, 64,
+           "max size of the shared bytecode table (in Mbytes)")
+
 DEFINE_BOOL(transition_strings_during_gc_with_stack, false,
             "Transition strings during a full GC with stack")
 
@@ -911,6 +951,9 @@ DEFINE_BOOL(turbo_inline_array_builtins, true,
             "inline array builtins in TurboFan code")
 DEFINE_BOOL(use_osr, true, "use on-stack replacement")
 DEFINE_BOOL(concurrent_osr, true, "enable concurrent OSR")
+DEFINE_BOOL(osr_past_maglev, false,
+            "OSR into Turbofan as soon as Maglev code is available for a "
+            "function whose unoptimized frame is stuck in a loop")
 
 DEFINE_BOOL(trace_osr, false, "trace on-stack replacement")
 DEFINE_BOOL(log_or_trace_osr, false,
@@ -1008,6 +1051,10 @@ DEFINE_BOOL(turboshaft_trace_reduction, false,
             "trace individual Turboshaft reduction steps")
 DEFINE_BOOL(turboshaft_wasm, false,
             "enable TurboFan's Turboshaft phases for wasm")
+DEFINE_BOOL(turboshaft_load_elimination, true,
+            "enable Turboshaft's late load elimination")
+DEFINE_BOOL(turboshaft_store_elimination, true,
+            "enable Turboshaft's store-store elimination")
 #ifdef DEBUG
 DEFINE_UINT64(turboshaft_opt_bisect_limit, std::numeric_limits<uint64_t>::max(),
               "stop applying optional optimizations after a specified number "
@@ -1035,6 +1082,11 @@ DEFINE_BOOL(wasm_generic_wrapper, true,
 DEFINE_BOOL(enable_wasm_arm64_generic_wrapper, true,
             "allow use of the generic js-to-wasm wrapper instead of "
             "per-signature wrappers on arm64")
+DEFINE_BOOL(wasm_shared_import_wrappers, true,
+            "share compiled wasm-to-js wrappers across modules and isolates")
+DEFINE_SIZE_T(wasm_shared_import_wrappers_max_size, 1 * MB,
+              "maximum size (in bytes) of the compiled wasm-to-js wrappers "
+              "kept for reuse by other modules")
 DEFINE_BOOL(expose_wasm, true, "expose wasm interface to JavaScript")
 DEFINE_INT(wasm_num_compilation_tasks, 128,
            "maximum number of parallel compilation tasks for wasm")
@@ -1121,6 +1173,13 @@ DEFINE_BOOL(
 DEFINE_BOOL(
     experimental_wasm_pgo_from_file, false,
     "experimental: read and use Wasm PGO data from a local file (for testing)")
+DEFINE_STRING(wasm_disk_cache_dir, nullptr,
+              "directory for a persistent on-disk cache of compiled Wasm "
+              "modules (disabled if not set)")
+DEFINE_INT(wasm_disk_cache_write_delay, 1000,
+           "delay (in ms) before tiered-up code is written to the Wasm disk "
+           "cache, so that tier-up chunks finishing in the meantime are written "
+           "together")
 
 DEFINE_BOOL(validate_asm, true, "validate asm.js modules before compiling")
 // asm.js validation is disabled since it triggers wasm code generation.
@@ -1723,6 +1782,11 @@ DEFINE_BOOL(external_reference_stats, false,
 
 // compilation-cache.cc
 DEFINE_BOOL(compilation_cache, true, "enable compilation cache")
+DEFINE_BOOL(process_wide_compilation_cache, false,
+            "share compiled scripts between isolates via a process-wide cache "
+            "of serialized code")
+DEFINE_INT(process_wide_compilation_cache_size, 64,
+           "maximum size of the process-wide compilation cache (in MB)")
 
 DEFINE_BOOL(cache_prototype_transitions, true, "cache prototype transitions")
 
@@ -1737,6 +1801,11 @@ DEFINE_BOOL(
     "spawn parallel compile tasks for eagerly compiled, top-level functions")
 DEFINE_IMPLICATION(parallel_compile_tasks_for_eager_toplevel,
                    lazy_compile_dispatcher)
+DEFINE_BOOL(parallel_compile_tasks_for_eager_inner, false,
+            "spawn parallel compile tasks for eagerly compiled, inner "
+            "functions, e.g. the modules of a bundle wrapped in an IIFE")
+DEFINE_IMPLICATION(parallel_compile_tasks_for_eager_inner,
+                   lazy_compile_dispatcher)
 DEFINE_BOOL(parallel_compile_tasks_for_lazy, false,
             "spawn parallel compile tasks for all lazily compiled functions")
 DEFINE_IMPLICATION(parallel_compile_tasks_for_lazy, lazy_compile_dispatcher)
@@ -1944,6 +2013,23 @@ DEFINE_BOOL(profile_deserialization, false,
             "Print the time it takes to deserialize the snapshot.")
 DEFINE_BOOL(serialization_statistics, false,
             "Collect statistics on serialized objects.")
+DEFINE_BOOL(lazy_snapshot_strings, false,
+            "Reference the characters of large one-byte strings in an "
+            "uncompressed startup snapshot instead of copying them, so that "
+            "they are only paged in on first access.")
+DEFINE_INT(lazy_snapshot_strings_min_length, 4 * KB,
+           "Minimum length of strings referenced by --lazy-snapshot-strings. "
+           "Shorter strings are copied eagerly.")
+// External strings can't be shared.
+DEFINE_NEG_IMPLICATION(shared_string_table, lazy_snapshot_strings)
+DEFINE_BOOL(concurrent_snapshot_decompression, true,
+            "Decompress the chunks of a compressed snapshot in parallel.")
+DEFINE_INT(snapshot_compression_chunk_size, 256 * KB,
+           "Size of the independently compressed chunks of a compressed "
+           "snapshot (in bytes).")
+DEFINE_BOOL(map_read_only_snapshot_pages, true,
+            "Map the read-only pages of a snapshot with static roots "
+            "copy-on-write from the binary, instead of copying them.")
 // Regexp
 DEFINE_BOOL(regexp_optimization, true, "generate optimized regexp code")
 DEFINE_BOOL(regexp_interpret_all, false, "interpret all regexp code")
@@ -2359,6 +2445,7 @@ DEFINE_NEG_IMPLICATION(predictable, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(predictable, stress_concurrent_inlining)
 DEFINE_NEG_IMPLICATION(predictable, lazy_compile_dispatcher)
 DEFINE_NEG_IMPLICATION(predictable, parallel_compile_tasks_for_eager_toplevel)
+DEFINE_NEG_IMPLICATION(predictable, parallel_compile_tasks_for_eager_inner)
 DEFINE_NEG_IMPLICATION(predictable, parallel_compile_tasks_for_lazy)
 
 DEFINE_BOOL(predictable_gc_schedule, false,
@@ -2382,7 +2469,9 @@ DEFINE_NEG_IMPLICATION(single_threaded, stress_concurrent_inlining)
 DEFINE_NEG_IMPLICATION(single_threaded, lazy_compile_dispatcher)
 DEFINE_NEG_IMPLICATION(single_threaded,
                        parallel_compile_tasks_for_eager_toplevel)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_compile_tasks_for_eager_inner)
 DEFINE_NEG_IMPLICATION(single_threaded, parallel_compile_tasks_for_lazy)
+DEFINE_NEG_IMPLICATION(single_threaded, concurrent_snapshot_decompression)
 
 //
 // Parallel and concurrent GC (Orinoco) related flags.
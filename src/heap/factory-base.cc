@@ -222,18 +222,20 @@ Handle<ByteArray> FactoryBase<Impl>::NewByteArray(int length,
 template <typename Impl>
 Handle<BytecodeArray> FactoryBase<Impl>::NewBytecodeArray(
     int length, const byte* raw_bytecodes, int frame_size, int parameter_count,
-    Handle<FixedArray> constant_pool) {
+    Handle<FixedArray> constant_pool, AllocationType allocation) {
   if (length < 0 || length > BytecodeArray::kMaxLength) {
     FATAL("Fatal JavaScript invalid size error %d", length);
     UNREACHABLE();
   }
-  // Bytecode array is AllocationType::kOld, so constant pool array should be
-  // too.
+  // Bytecode array is AllocationType::kOld or kSharedOld, so constant pool
+  // array should be too.
+  DCHECK(allocation == AllocationType::kOld ||
+         allocation == AllocationType::kSharedOld);
   DCHECK(!Heap::InYoungGeneration(*constant_pool));
 
   int size = BytecodeArray::SizeFor(length);
   HeapObject result = AllocateRawWithImmortalMap(
-      size, AllocationType::kOld, read_only_roots().bytecode_array_map());
+      size, allocation, read_only_roots().bytecode_array_map());
   DisallowGarbageCollection no_gc;
   BytecodeArray instance = BytecodeArray::cast(result);
   instance.set_length(length);
@@ -90,6 +90,7 @@
 #include "src/init/bootstrapper.h"
 #include "src/init/v8.h"
 #include "src/interpreter/interpreter.h"
+#include "src/interpreter/shared-bytecode-table.h"
 #include "src/logging/log.h"
 #include "src/logging/runtime-call-stats-scope.h"
 #include "src/numbers/conversions.h"
@@ -4740,6 +4741,15 @@ void Heap::IterateRoots(RootVisitor* v, base::EnumSet<SkipRoot> options) {
       SerializerDeserializer::IterateSharedHeapObjectCache(isolate_, v);
       v->Synchronize(VisitorSynchronization::kSharedHeapObjectCache);
     }
+
+    // The shared bytecode table is only iterated by the isolate owning the
+    // shared heap, like the string table.
+    if (isolate_->is_shared_heap_isolate() &&
+        isolate_->shared_bytecode_table() &&
+        !options.contains(SkipRoot::kOldGeneration)) {
+      isolate_->shared_bytecode_table()->IterateElements(v);
+      v->Synchronize(VisitorSynchronization::kSharedBytecodeTable);
+    }
   }
 
   if (!options.contains(SkipRoot::kWeak)) {
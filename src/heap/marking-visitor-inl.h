@@ -166,7 +166,9 @@ int MarkingVisitorBase<ConcreteVisitor, MarkingState>::VisitBytecodeArray(
   int size = BytecodeArray::BodyDescriptor::SizeOf(map, object);
   this->VisitMapPointer(object);
   BytecodeArray::BodyDescriptor::IterateBody(map, object, size, this);
-  if (!should_keep_ages_unchanged_) {
+  // Bytecode in the shared heap is used by several isolates and is never
+  // flushed, so it keeps its initial age and is never written to.
+  if (!should_keep_ages_unchanged_ && !object.InSharedWritableHeap()) {
     object.MakeOlder();
   }
   return size;
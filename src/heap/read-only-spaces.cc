@@ -19,10 +19,13 @@
 #include "src/heap/marking-state-inl.h"
 #include "src/heap/memory-allocator.h"
 #include "src/heap/read-only-heap.h"
+#include "src/logging/counters.h"
 #include "src/objects/objects-inl.h"
 #include "src/snapshot/snapshot-data.h"
 #include "src/snapshot/snapshot-source-sink.h"
 #include "src/snapshot/snapshot-utils.h"
+#include "src/snapshot/snapshot.h"
+#include "src/utils/allocation.h"
 
 namespace v8 {
 namespace internal {
@@ -764,6 +767,45 @@ SharedReadOnlySpace::SharedReadOnlySpace(Heap* heap,
   pages_ = artifacts->pages();
 }
 
+namespace {
+
+// Copies the dumped contents of a read-only page into the page area at {dst}.
+// If the snapshot blob is backed by a file (e.g. if it is embedded in the
+// binary) and the contents are suitably aligned, the OS pages covered by them
+// are instead mapped copy-on-write from that file. They then stay clean unless
+// written to, and are shared with other processes through the page cache.
+// Returns the number of bytes that were mapped.
+size_t CopyOrMapPageContents(const byte* src, Address dst, size_t size) {
+  if constexpr (base::OS::IsRemapPageSupported()) {
+    const size_t page_size = GetPlatformPageAllocator()->AllocatePageSize();
+    Address map_start = RoundUp(dst, page_size);
+    Address map_end = RoundDown(dst + size, page_size);
+    if (v8_flags.map_read_only_snapshot_pages && map_start < map_end &&
+        IsAligned(reinterpret_cast<Address>(src) + (map_start - dst),
+                  page_size) &&
+        base::OS::RemapPages(src + (map_start - dst), map_end - map_start,
+                             reinterpret_cast<void*>(map_start),
+                             base::OS::MemoryPermission::kReadWrite)) {
+      // The partial OS pages at both ends are shared with the page header and
+      // the unused part of the page area, so they are copied.
+      MemCopy(reinterpret_cast<void*>(dst), src, map_start - dst);
+      MemCopy(reinterpret_cast<void*>(map_end), src + (map_end - dst),
+              dst + size - map_end);
+      return map_end - map_start;
+    }
+  }
+  MemCopy(reinterpret_cast<void*>(dst), src, size);
+  return 0;
+}
+
+}  // namespace
+
+// static
+int ReadOnlySpace::SnapshotPagePadding(int position, Address area_start) {
+  return static_cast<int>((area_start - position) &
+                          (Snapshot::kReadOnlyPageAlignment - 1));
+}
+
 void ReadOnlySpace::InitFromMemoryDump(Isolate* isolate,
                                        SnapshotByteSource* in) {
   size_t num_pages = in->GetInt();
@@ -791,7 +833,11 @@ void ReadOnlySpace::InitFromMemoryDump(Isolate* isolate,
     CHECK_NOT_NULL(chunk);
 
     CHECK_LE(chunk->area_start() + size, chunk->area_end());
-    in->CopyRaw(reinterpret_cast<void*>(chunk->area_start()), size);
+    in->Advance(SnapshotPagePadding(in->position(), chunk->area_start()));
+    size_t mapped_bytes =
+        CopyOrMapPageContents(in->GetRaw(size), chunk->area_start(), size);
+    isolate->counters()->read_only_snapshot_bytes_mapped()->Increment(
+        static_cast<int>(mapped_bytes));
     chunk->IncreaseAllocatedBytes(size);
     chunk->high_water_mark_ = (chunk->area_start() - chunk->address()) + size;
 
@@ -238,6 +238,11 @@ class ReadOnlySpace : public BaseSpace {
 
   void InitFromMemoryDump(Isolate* isolate, SnapshotByteSource* source);
 
+  // Returns the number of padding bytes in front of the contents of a page
+  // dumped at {position} of the read-only snapshot payload, such that the
+  // contents are aligned like the page area starting at {area_start}.
+  static int SnapshotPagePadding(int position, Address area_start);
+
   // Ensure the read only space has at least one allocated page
   void EnsurePage();
 
@@ -18,6 +18,7 @@
 #include "src/init/setup-isolate.h"
 #include "src/interpreter/bytecode-generator.h"
 #include "src/interpreter/bytecodes.h"
+#include "src/interpreter/shared-bytecode-table.h"
 #include "src/logging/runtime-call-stats-scope.h"
 #include "src/objects/objects-inl.h"
 #include "src/objects/shared-function-info.h"
@@ -264,7 +265,8 @@ template <typename IsolateT>
 InterpreterCompilationJob::Status InterpreterCompilationJob::DoFinalizeJobImpl(
     Handle<SharedFunctionInfo> shared_info, IsolateT* isolate) {
   Handle<BytecodeArray> bytecodes = compilation_info_.bytecode_array();
-  if (bytecodes.is_null()) {
+  const bool is_new_bytecode = bytecodes.is_null();
+  if (is_new_bytecode) {
     bytecodes = generator()->FinalizeBytecode(
         isolate, handle(Script::cast(shared_info->script()), isolate));
     if (generator()->HasStackOverflow()) {
@@ -280,6 +282,13 @@ InterpreterCompilationJob::Status InterpreterCompilationJob::DoFinalizeJobImpl(
     bytecodes->set_source_position_table(*source_position_table, kReleaseStore);
   }
 
+  // Replace freshly generated bytecode by an identical copy from the shared
+  // heap, if possible.
+  if (is_new_bytecode && isolate->shared_bytecode_table() != nullptr) {
+    bytecodes = isolate->shared_bytecode_table()->Share(isolate, bytecodes);
+    compilation_info()->SetBytecodeArray(bytecodes);
+  }
+
   if (ShouldPrintBytecode(shared_info)) {
     StdoutStream os;
     std::unique_ptr<char[]> name =
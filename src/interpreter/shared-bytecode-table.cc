@@ -0,0 +1,223 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/interpreter/shared-bytecode-table.h"
+
+#include "src/base/functional.h"
+#include "src/execution/isolate.h"
+#include "src/execution/local-isolate.h"
+#include "src/heap/factory.h"
+#include "src/heap/local-factory-inl.h"
+#include "src/heap/read-only-heap.h"
+#include "src/objects/code-inl.h"
+#include "src/objects/fixed-array-inl.h"
+#include "src/objects/string-inl.h"
+#include "src/objects/visitors.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+namespace {
+
+size_t MaxSize() {
+  return static_cast<size_t>(v8_flags.shared_bytecode_max_size) * MB;
+}
+
+bool IsShareableConstant(Object object) {
+  if (object.IsSmi()) return true;
+  HeapObject heap_object = HeapObject::cast(object);
+  if (ReadOnlyHeap::Contains(heap_object)) return true;
+  return heap_object.IsInternalizedString() &&
+         heap_object.InSharedWritableHeap();
+}
+
+size_t HashConstant(Object object) {
+  if (object.IsSmi()) return base::hash_value(Smi::ToInt(object));
+  // Internalized strings in the shared heap can move, but their hash is stable.
+  if (object.IsInternalizedString()) {
+    return base::hash_value(String::cast(object).EnsureHash());
+  }
+  // Read-only objects don't move.
+  return base::hash_value(object.ptr());
+}
+
+size_t HashBytes(ByteArray bytes) {
+  const byte* start = bytes.GetDataStartAddress();
+  return base::hash_range(start, start + bytes.length());
+}
+
+bool BytesEqual(ByteArray a, ByteArray b) {
+  return a.length() == b.length() &&
+         memcmp(a.GetDataStartAddress(), b.GetDataStartAddress(),
+                a.length()) == 0;
+}
+
+template <typename IsolateT>
+Handle<ByteArray> CopyByteArrayToSharedHeap(IsolateT* isolate,
+                                            ByteArray bytes) {
+  if (ReadOnlyHeap::Contains(bytes)) return handle(bytes, isolate);
+  Handle<ByteArray> copy = isolate->factory()->NewByteArray(
+      bytes.length(), AllocationType::kSharedOld);
+  copy->copy_in(0, bytes.GetDataStartAddress(), bytes.length());
+  return copy;
+}
+
+}  // namespace
+
+// static
+bool SharedBytecodeTable::IsShareable(BytecodeArray bytecode) {
+  // Shared objects may only point to other shared objects, which includes the
+  // read-only heap only if it is shared, too.
+  if (!ReadOnlyHeap::IsReadOnlySpaceShared()) return false;
+  // The source position table must be final, since lazily collecting it would
+  // have to write to the shared BytecodeArray.
+  if (!bytecode.source_position_table(kAcquireLoad).IsByteArray()) {
+    return false;
+  }
+  FixedArray constant_pool = bytecode.constant_pool();
+  for (int i = 0; i < constant_pool.length(); ++i) {
+    if (!IsShareableConstant(constant_pool.get(i))) return false;
+  }
+  return true;
+}
+
+// static
+size_t SharedBytecodeTable::Hash(BytecodeArray bytecode) {
+  DisallowGarbageCollection no_gc;
+  const byte* start =
+      reinterpret_cast<const byte*>(bytecode.GetFirstBytecodeAddress());
+  size_t hash = base::hash_combine(
+      base::hash_range(start, start + bytecode.length()),
+      bytecode.frame_size(), bytecode.parameter_count(),
+      bytecode.incoming_new_target_or_generator_register().index(),
+      HashBytes(bytecode.handler_table()),
+      HashBytes(bytecode.SourcePositionTable()));
+  FixedArray constant_pool = bytecode.constant_pool();
+  for (int i = 0; i < constant_pool.length(); ++i) {
+    hash = base::hash_combine(hash, HashConstant(constant_pool.get(i)));
+  }
+  return hash;
+}
+
+// static
+bool SharedBytecodeTable::Equals(BytecodeArray shared, BytecodeArray bytecode) {
+  DisallowGarbageCollection no_gc;
+  if (shared.length() != bytecode.length() ||
+      shared.frame_size() != bytecode.frame_size() ||
+      shared.parameter_count() != bytecode.parameter_count() ||
+      shared.incoming_new_target_or_generator_register() !=
+          bytecode.incoming_new_target_or_generator_register()) {
+    return false;
+  }
+  if (memcmp(reinterpret_cast<void*>(shared.GetFirstBytecodeAddress()),
+             reinterpret_cast<void*>(bytecode.GetFirstBytecodeAddress()),
+             bytecode.length()) != 0) {
+    return false;
+  }
+  if (!BytesEqual(shared.handler_table(), bytecode.handler_table()) ||
+      !BytesEqual(shared.SourcePositionTable(),
+                  bytecode.SourcePositionTable())) {
+    return false;
+  }
+  // All constants are canonical (Smis, read-only objects and internalized
+  // strings), so they can be compared by identity.
+  FixedArray shared_constant_pool = shared.constant_pool();
+  FixedArray constant_pool = bytecode.constant_pool();
+  if (shared_constant_pool.length() != constant_pool.length()) return false;
+  for (int i = 0; i < constant_pool.length(); ++i) {
+    if (shared_constant_pool.get(i) != constant_pool.get(i)) return false;
+  }
+  return true;
+}
+
+// static
+template <typename IsolateT>
+Handle<BytecodeArray> SharedBytecodeTable::CopyToSharedHeap(
+    IsolateT* isolate, Handle<BytecodeArray> bytecode) {
+  Handle<FixedArray> constant_pool(bytecode->constant_pool(), isolate);
+  if (!ReadOnlyHeap::Contains(*constant_pool)) {
+    Handle<FixedArray> shared_constant_pool =
+        isolate->factory()->NewFixedArray(constant_pool->length(),
+                                          AllocationType::kSharedOld);
+    constant_pool->CopyTo(0, *shared_constant_pool, 0,
+                          constant_pool->length());
+    constant_pool = shared_constant_pool;
+  }
+  Handle<ByteArray> handler_table =
+      CopyByteArrayToSharedHeap(isolate, bytecode->handler_table());
+  Handle<ByteArray> source_position_table =
+      CopyByteArrayToSharedHeap(isolate, bytecode->SourcePositionTable());
+
+  Handle<BytecodeArray> shared = isolate->factory()->NewBytecodeArray(
+      bytecode->length(),
+      reinterpret_cast<const byte*>(bytecode->GetFirstBytecodeAddress()),
+      bytecode->frame_size(), bytecode->parameter_count(), constant_pool,
+      AllocationType::kSharedOld);
+  shared->set_incoming_new_target_or_generator_register(
+      bytecode->incoming_new_target_or_generator_register());
+  shared->set_handler_table(*handler_table);
+  shared->set_source_position_table(*source_position_table, kReleaseStore);
+  return shared;
+}
+
+Address SharedBytecodeTable::Lookup(size_t hash, BytecodeArray bytecode) {
+  mutex_.AssertHeld();
+  auto range = entries_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    BytecodeArray shared = BytecodeArray::cast(Object(it->second));
+    if (Equals(shared, bytecode)) return it->second;
+  }
+  return kNullAddress;
+}
+
+template <typename IsolateT>
+Handle<BytecodeArray> SharedBytecodeTable::Share(
+    IsolateT* isolate, Handle<BytecodeArray> bytecode) {
+  DCHECK(v8_flags.shared_bytecode);
+  DCHECK_EQ(this, isolate->shared_bytecode_table());
+  if (!IsShareable(*bytecode)) return bytecode;
+
+  size_t hash = Hash(*bytecode);
+  {
+    base::MutexGuard guard(&mutex_);
+    Address shared = Lookup(hash, *bytecode);
+    if (shared != kNullAddress) {
+      return handle(BytecodeArray::cast(Object(shared)), isolate);
+    }
+    if (size_ >= MaxSize()) return bytecode;
+  }
+
+  // Allocate outside of the lock: allocation can trigger a shared GC, which
+  // has to wait for other threads that might be waiting for the lock.
+  Handle<BytecodeArray> shared = CopyToSharedHeap(isolate, bytecode);
+
+  base::MutexGuard guard(&mutex_);
+  // Another thread might have added the same bytecode in the meantime.
+  Address existing = Lookup(hash, *bytecode);
+  if (existing != kNullAddress) {
+    return handle(BytecodeArray::cast(Object(existing)), isolate);
+  }
+  entries_.emplace(hash, shared->ptr());
+  size_ += shared->SizeIncludingMetadata();
+  return shared;
+}
+
+template V8_EXPORT_PRIVATE Handle<BytecodeArray> SharedBytecodeTable::Share(
+    Isolate* isolate, Handle<BytecodeArray> bytecode);
+template V8_EXPORT_PRIVATE Handle<BytecodeArray> SharedBytecodeTable::Share(
+    LocalIsolate* isolate, Handle<BytecodeArray> bytecode);
+
+void SharedBytecodeTable::IterateElements(RootVisitor* visitor) {
+  // No need to take the lock: this is only called during a safepoint, and the
+  // lock is never held across one.
+  for (auto& [hash, entry] : entries_) {
+    visitor->VisitRootPointer(Root::kSharedBytecodeTable, nullptr,
+                              FullObjectSlot(&entry));
+  }
+}
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,79 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_INTERPRETER_SHARED_BYTECODE_TABLE_H_
+#define V8_INTERPRETER_SHARED_BYTECODE_TABLE_H_
+
+#include <unordered_map>
+
+#include "src/base/platform/mutex.h"
+#include "src/common/globals.h"
+#include "src/handles/handles.h"
+
+namespace v8 {
+namespace internal {
+
+class BytecodeArray;
+class RootVisitor;
+
+namespace interpreter {
+
+// A table of BytecodeArrays in the shared heap (--shared-bytecode), owned by
+// the Isolate owning the shared heap and used by all its clients.
+//
+// Every Isolate generates its own bytecode for the functions it compiles, even
+// if another Isolate already compiled the very same function. Bytecode which
+// only refers to objects that are shared themselves (Smis, read-only objects
+// and internalized strings from the shared string table) is replaced by a
+// single copy in the shared heap, so that all Isolates compiling the same
+// function reference the same BytecodeArray. Feedback is unaffected, since it
+// lives in the Isolate's FeedbackVectors and not in the BytecodeArray.
+//
+// The age of shared bytecode stays 0: marking doesn't age it and the
+// interpreter entry only resets ages which aren't 0 (x64 and ia32 only, hence
+// the flag is read-only elsewhere), so no Isolate writes to it.
+//
+// Entries are strong and never removed; the table just stops growing once it
+// reaches --shared-bytecode-max-size.
+class V8_EXPORT_PRIVATE SharedBytecodeTable final {
+ public:
+  SharedBytecodeTable() = default;
+  SharedBytecodeTable(const SharedBytecodeTable&) = delete;
+  SharedBytecodeTable& operator=(const SharedBytecodeTable&) = delete;
+
+  // Returns the shared BytecodeArray with the same content as {bytecode},
+  // adding a copy of {bytecode} to the table if there is none yet. Returns
+  // {bytecode} itself if it can't be shared.
+  template <typename IsolateT>
+  Handle<BytecodeArray> Share(IsolateT* isolate,
+                              Handle<BytecodeArray> bytecode);
+
+  // GC support. Only called by the Isolate owning the shared heap.
+  void IterateElements(RootVisitor* visitor);
+
+ private:
+  static bool IsShareable(BytecodeArray bytecode);
+  static size_t Hash(BytecodeArray bytecode);
+  static bool Equals(BytecodeArray shared, BytecodeArray bytecode);
+
+  template <typename IsolateT>
+  static Handle<BytecodeArray> CopyToSharedHeap(IsolateT* isolate,
+                                                Handle<BytecodeArray> bytecode);
+
+  // Returns the address of the shared BytecodeArray with the same content as
+  // {bytecode}, or kNullAddress. Must be called with {mutex_} held.
+  Address Lookup(size_t hash, BytecodeArray bytecode);
+
+  base::Mutex mutex_;
+  // Tagged BytecodeArray pointers, by Hash(). Map nodes are stable, so the GC
+  // can update the values in place.
+  std::unordered_multimap<size_t, Address> entries_;
+  size_t size_ = 0;
+};
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_INTERPRETER_SHARED_BYTECODE_TABLE_H_
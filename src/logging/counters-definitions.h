@@ -215,6 +215,9 @@ namespace internal {
      MILLISECOND)                                                              \
   HT(wasm_tier_up_module_time, V8.WasmTierUpModuleMicroSeconds, 100000000,     \
      MICROSECOND)                                                              \
+  /* time from detecting a function as hot until its top-tier code is done */  \
+  HT(wasm_tier_up_latency, V8.WasmTierUpLatencyMicroSeconds, 10000000,         \
+     MICROSECOND)                                                              \
   HT(wasm_compile_asm_function_time, V8.WasmCompileFunctionMicroSeconds.asm,   \
      1000000, MICROSECOND)                                                     \
   HT(wasm_compile_wasm_function_time, V8.WasmCompileFunctionMicroSeconds.wasm, \
@@ -304,17 +307,20 @@ namespace internal {
 // lines) rather than one macro (of length about 80 lines) to work around
 // this problem.  Please avoid using recursive macros of this length when
 // possible.
-#define STATS_COUNTER_LIST_1(SC)                                     \
-  /* Global Handle Count*/                                           \
-  SC(global_handles, V8.GlobalHandles)                               \
-  SC(alive_after_last_gc, V8.AliveAfterLastGC)                       \
-  SC(compilation_cache_hits, V8.CompilationCacheHits)                \
-  SC(compilation_cache_misses, V8.CompilationCacheMisses)            \
-  /* Number of times the cache contained a reusable Script but not   \
-     the root SharedFunctionInfo */                                  \
-  SC(compilation_cache_partial_hits, V8.CompilationCachePartialHits) \
-  SC(objs_since_last_young, V8.ObjsSinceLastYoung)                   \
-  SC(objs_since_last_full, V8.ObjsSinceLastFull)
+#define STATS_COUNTER_LIST_1(SC)                                              \
+  /* Global Handle Count*/                                                    \
+  SC(global_handles, V8.GlobalHandles)                                        \
+  SC(alive_after_last_gc, V8.AliveAfterLastGC)                                \
+  SC(compilation_cache_hits, V8.CompilationCacheHits)                         \
+  SC(compilation_cache_misses, V8.CompilationCacheMisses)                     \
+  /* Number of times the cache contained a reusable Script but not            \
+     the root SharedFunctionInfo */                                           \
+  SC(compilation_cache_partial_hits, V8.CompilationCachePartialHits)          \
+  SC(compilation_cache_process_wide_hits, V8.CompilationCacheProcessWideHits) \
+  SC(objs_since_last_young, V8.ObjsSinceLastYoung)                            \
+  SC(objs_since_last_full, V8.ObjsSinceLastFull)                              \
+  /* Bytes of read-only snapshot pages mapped instead of copied */            \
+  SC(read_only_snapshot_bytes_mapped, V8.ReadOnlySnapshotBytesMapped)
 
 #define STATS_COUNTER_LIST_2(SC)                                               \
   SC(gc_compactor_caused_by_request, V8.GCCompactorCausedByRequest)            \
@@ -344,7 +350,9 @@ namespace internal {
   SC(wasm_generated_code_size, V8.WasmGeneratedCodeBytes)                      \
   SC(wasm_reloc_size, V8.WasmRelocBytes)                                       \
   SC(wasm_lazily_compiled_functions, V8.WasmLazilyCompiledFunctions)           \
-  SC(wasm_compiled_export_wrapper, V8.WasmCompiledExportWrappers)
+  SC(wasm_compiled_export_wrapper, V8.WasmCompiledExportWrappers)              \
+  SC(wasm_reused_import_wrappers, V8.WasmReusedImportWrappers)                 \
+  SC(wasm_reused_import_wrapper_size, V8.WasmReusedImportWrapperBytes)
 
 // List of counters that can be incremented from generated code. We need them in
 // a separate list to be able to relocate them.
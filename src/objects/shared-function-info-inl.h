@@ -637,6 +637,10 @@ bool SharedFunctionInfo::ShouldFlushCode(
   }
   if (!data.IsBytecodeArray()) return false;
 
+  // Bytecode in the shared heap is kept alive by the SharedBytecodeTable
+  // anyway, so flushing it wouldn't free any memory.
+  if (data.InSharedWritableHeap()) return false;
+
   if (IsStressFlushingEnabled(code_flush_mode)) return true;
 
   BytecodeArray bytecode = BytecodeArray::cast(data);
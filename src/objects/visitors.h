@@ -39,6 +39,7 @@ class Code;
   V(kStartupObjectCache, "(Startup object cache)")      \
   V(kReadOnlyObjectCache, "(Read-only object cache)")   \
   V(kSharedHeapObjectCache, "(Shareable object cache)") \
+  V(kSharedBytecodeTable, "(Shared bytecode table)")     \
   V(kWeakCollections, "(Weak collections)")             \
   V(kWrapperTracing, "(Wrapper tracing)")               \
   V(kWriteBarrier, "(Write barrier)")                   \
@@ -38,6 +38,22 @@ class LiteralBuffer final {
     AddTwoByteChar(code_unit);
   }
 
+  // Adds the ASCII code units in [start, end).
+  V8_INLINE void AddAsciiChars(const uint16_t* start, const uint16_t* end) {
+    if (V8_UNLIKELY(!is_one_byte())) {
+      for (const uint16_t* it = start; it < end; ++it) AddTwoByteChar(*it);
+      return;
+    }
+    int length = static_cast<int>(end - start);
+    while (position_ + length > backing_store_.length()) ExpandBuffer();
+    byte* dst = backing_store_.begin() + position_;
+    for (int i = 0; i < length; ++i) {
+      DCHECK_LE(start[i], unibrow::Utf8::kMaxOneByteChar);
+      dst[i] = static_cast<byte>(start[i]);
+    }
+    position_ += length;
+  }
+
   bool is_one_byte() const { return is_one_byte_; }
 
   bool Equals(base::Vector<const char> keyword) const {
@@ -38,6 +38,8 @@ UnoptimizedCompileFlags::UnoptimizedCompileFlags(Isolate* isolate,
                                isolate->NeedsDetailedOptimizedCodeLineInfo());
   set_post_parallel_compile_tasks_for_eager_toplevel(
       v8_flags.parallel_compile_tasks_for_eager_toplevel);
+  set_post_parallel_compile_tasks_for_eager_inner(
+      v8_flags.parallel_compile_tasks_for_eager_inner);
   set_post_parallel_compile_tasks_for_lazy(
       v8_flags.parallel_compile_tasks_for_lazy);
 }
@@ -195,6 +197,8 @@ ParseInfo::ParseInfo(const UnoptimizedCompileFlags flags,
       state_(state),
       reusable_state_(reusable_state),
       extension_(nullptr),
+      compile_hint_callback_(nullptr),
+      compile_hint_callback_data_(nullptr),
       script_scope_(nullptr),
       stack_limit_(stack_limit),
       parameters_end_pos_(kNoSourcePosition),
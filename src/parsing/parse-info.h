@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "include/v8-script.h"
 #include "src/base/bit-field.h"
 #include "src/base/export-template.h"
 #include "src/base/logging.h"
@@ -59,10 +60,12 @@ class Zone;
   V(allow_natives_syntax, bool, 1, _)                           \
   V(allow_lazy_compile, bool, 1, _)                             \
   V(post_parallel_compile_tasks_for_eager_toplevel, bool, 1, _) \
+  V(post_parallel_compile_tasks_for_eager_inner, bool, 1, _)    \
   V(post_parallel_compile_tasks_for_lazy, bool, 1, _)           \
   V(collect_source_positions, bool, 1, _)                       \
   V(is_repl_mode, bool, 1, _)                                   \
-  V(produce_compile_hints, bool, 1, _)
+  V(produce_compile_hints, bool, 1, _)                          \
+  V(consume_compile_hints, bool, 1, _)
 
 class V8_EXPORT_PRIVATE UnoptimizedCompileFlags {
  public:
@@ -291,6 +294,20 @@ class V8_EXPORT_PRIVATE ParseInfo {
   v8::Extension* extension() const { return extension_; }
   void set_extension(v8::Extension* extension) { extension_ = extension; }
 
+  // The embedder callback deciding which functions to compile eagerly when
+  // consuming compile hints.
+  v8::ScriptCompiler::CompileHintCallback compile_hint_callback() const {
+    return compile_hint_callback_;
+  }
+  void* compile_hint_callback_data() const {
+    return compile_hint_callback_data_;
+  }
+  void set_compile_hint_callback(
+      v8::ScriptCompiler::CompileHintCallback callback, void* data) {
+    compile_hint_callback_ = callback;
+    compile_hint_callback_data_ = data;
+  }
+
   void set_consumed_preparse_data(std::unique_ptr<ConsumedPreparseData> data) {
     consumed_preparse_data_.swap(data);
   }
@@ -360,6 +377,8 @@ class V8_EXPORT_PRIVATE ParseInfo {
   ReusableUnoptimizedCompileState* reusable_state_;
 
   v8::Extension* extension_;
+  v8::ScriptCompiler::CompileHintCallback compile_hint_callback_;
+  void* compile_hint_callback_data_;
   DeclarationScope* script_scope_;
   uintptr_t stack_limit_;
   int parameters_end_pos_;
@@ -2655,6 +2655,18 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
           ? FunctionLiteral::kShouldEagerCompile
           : default_eager_compile_hint();
 
+  // Functions which the embedder reports as having been compiled in a previous
+  // run are compiled eagerly. The compile hints record the start position of
+  // the function, i.e. the position of its opening parenthesis.
+  if (V8_UNLIKELY(flags().consume_compile_hints()) &&
+      eager_compile_hint == FunctionLiteral::kShouldLazyCompile) {
+    DCHECK_NOT_NULL(info()->compile_hint_callback());
+    if (info()->compile_hint_callback()(
+            peek_position(), info()->compile_hint_callback_data())) {
+      eager_compile_hint = FunctionLiteral::kShouldEagerCompile;
+    }
+  }
+
   // Determine if the function can be parsed lazily. Lazy parsing is
   // different from lazy compilation; we need to parse more eagerly than we
   // compile.
@@ -2695,6 +2707,7 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
       eager_compile_hint == FunctionLiteral::kShouldLazyCompile;
   const bool is_top_level = AllowsLazyParsingWithoutUnresolvedVariables();
   const bool is_eager_top_level_function = !is_lazy && is_top_level;
+  const bool is_eager_inner_function = !is_lazy && !is_top_level;
 
   RCS_SCOPE(runtime_call_stats_, RuntimeCallCounterId::kParseFunctionLiteral,
             RuntimeCallStats::kThreadSpecific);
@@ -2714,11 +2727,16 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
       scanner()->stream()->can_be_cloned_for_parallel_access();
 
   // If parallel compile tasks are enabled, and this isn't a re-parse, enable
-  // parallel compile for the subset of functions as defined by flags.
+  // parallel compile for the subset of functions as defined by flags. Eager
+  // inner functions are preparsed with variable resolution, which records
+  // the function boundaries and the outer variables they use, so that their
+  // full parse and compile can happen on a background thread as well.
   bool should_post_parallel_task =
       can_post_parallel_task && !flags().is_reparse() &&
       ((is_eager_top_level_function &&
         flags().post_parallel_compile_tasks_for_eager_toplevel()) ||
+       (is_eager_inner_function &&
+        flags().post_parallel_compile_tasks_for_eager_inner()) ||
        (is_lazy && flags().post_parallel_compile_tasks_for_lazy()));
 
   // Determine whether we should lazy parse the inner function. This will be
@@ -5,11 +5,24 @@
 #ifndef V8_PARSING_SCANNER_INL_H_
 #define V8_PARSING_SCANNER_INL_H_
 
+#include <algorithm>
+
+#include "src/base/bits.h"
 #include "src/parsing/keywords-gen.h"
 #include "src/parsing/scanner.h"
 #include "src/strings/char-predicates-inl.h"
 #include "src/utils/utils.h"
 
+// SSE2 is part of the x64 baseline; MSVC doesn't define __SSE2__ for it.
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define V8_SCANNER_SSE2
+#include <emmintrin.h>
+#elif defined(V8_HOST_ARCH_ARM64)
+#define V8_SCANNER_NEON
+#include <arm_neon.h>
+#endif
+
 namespace v8 {
 namespace internal {
 
@@ -256,6 +269,165 @@ inline bool CharCanBeKeyword(base::uc32 c) {
          CanBeKeyword(character_scan_flags[c]);
 }
 
+// ----------------------------------------------------------------------------
+// Vectorized run skipping
+//
+// Comments, whitespace, string literals and identifiers are mostly long runs
+// of ASCII characters that the scanner loops don't stop at. The functions below
+// find the end of such runs 8 code units at a time, using a vector predicate
+// which yields all ones in the lanes that end the run. The remaining tail of
+// the buffer, and hosts without SSE2 or Neon, use the scalar predicate.
+
+namespace scanner_simd {
+
+static constexpr int kLanes = 8;
+static constexpr uint16_t kMaxAscii = 127;
+
+#if defined(V8_SCANNER_SSE2)
+using Vector = __m128i;
+
+V8_INLINE Vector Load(const uint16_t* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+V8_INLINE Vector Splat(uint16_t c) { return _mm_set1_epi16(c); }
+V8_INLINE Vector Eq(Vector v, uint16_t c) {
+  return _mm_cmpeq_epi16(v, Splat(c));
+}
+V8_INLINE Vector Or(Vector a, Vector b) { return _mm_or_si128(a, b); }
+V8_INLINE Vector Not(Vector v) { return _mm_xor_si128(v, Splat(0xFFFF)); }
+// Lanes in [lo, hi], compared as unsigned: v - lo <= hi - lo.
+V8_INLINE Vector InRange(Vector v, uint16_t lo, uint16_t hi) {
+  Vector diff = _mm_sub_epi16(v, Splat(lo));
+  return _mm_cmpeq_epi16(_mm_subs_epu16(diff, Splat(hi - lo)),
+                         _mm_setzero_si128());
+}
+// Returns the index of the first lane that is all ones, or kLanes.
+V8_INLINE int FirstSetLane(Vector mask) {
+  uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(mask));
+  if (bits == 0) return kLanes;
+  return base::bits::CountTrailingZeros(bits) / 2;
+}
+#elif defined(V8_SCANNER_NEON)
+using Vector = uint16x8_t;
+
+V8_INLINE Vector Load(const uint16_t* p) { return vld1q_u16(p); }
+V8_INLINE Vector Splat(uint16_t c) { return vdupq_n_u16(c); }
+V8_INLINE Vector Eq(Vector v, uint16_t c) { return vceqq_u16(v, Splat(c)); }
+V8_INLINE Vector Or(Vector a, Vector b) { return vorrq_u16(a, b); }
+V8_INLINE Vector Not(Vector v) { return vmvnq_u16(v); }
+V8_INLINE Vector InRange(Vector v, uint16_t lo, uint16_t hi) {
+  return vcleq_u16(vsubq_u16(v, Splat(lo)), Splat(hi - lo));
+}
+V8_INLINE int FirstSetLane(Vector mask) {
+  // Narrowing turns every lane into one byte of {bits}.
+  uint64_t bits = vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(mask)), 0);
+  if (bits == 0) return kLanes;
+  return base::bits::CountTrailingZeros(bits) / 8;
+}
+#endif
+
+// Returns the first code unit in [start, end) that ends the run.
+template <typename VectorStop, typename ScalarStop>
+V8_INLINE const uint16_t* FindRunEnd(const uint16_t* start,
+                                     const uint16_t* end,
+                                     VectorStop vector_stop,
+                                     ScalarStop scalar_stop) {
+#if defined(V8_SCANNER_SSE2) || defined(V8_SCANNER_NEON)
+  for (; end - start >= kLanes; start += kLanes) {
+    int lane = FirstSetLane(vector_stop(Load(start)));
+    if (lane != kLanes) return start + lane;
+  }
+#endif
+  return std::find_if(start, end, scalar_stop);
+}
+
+#if defined(V8_SCANNER_SSE2) || defined(V8_SCANNER_NEON)
+V8_INLINE Vector IsNonAscii(Vector v) {
+  return Not(InRange(v, 0, kMaxAscii));
+}
+V8_INLINE Vector AsciiAlphaToLower(Vector v) { return Or(v, Splat(0x20)); }
+#endif
+
+V8_INLINE bool IsNonAscii(uint16_t c) { return c > kMaxAscii; }
+
+// Spaces and tabs, the bulk of indentation.
+V8_INLINE const uint16_t* SkipSpaces(const uint16_t* start,
+                                     const uint16_t* end) {
+  return FindRunEnd(
+      start, end,
+      [](auto v) { return Not(Or(Eq(v, ' '), Eq(v, '\t'))); },
+      [](uint16_t c) { return c != ' ' && c != '\t'; });
+}
+
+// The body of a single line comment, up to a (possible) line terminator.
+V8_INLINE const uint16_t* SkipSingleLineCommentBody(const uint16_t* start,
+                                                    const uint16_t* end) {
+  return FindRunEnd(
+      start, end,
+      [](auto v) { return Or(Or(Eq(v, '\n'), Eq(v, '\r')), IsNonAscii(v)); },
+      [](uint16_t c) { return c == '\n' || c == '\r' || IsNonAscii(c); });
+}
+
+// The body of a multi line comment before its first line terminator, which
+// needs to look for '*' and (possible) line terminators.
+V8_INLINE const uint16_t* SkipMultiLineCommentBody(const uint16_t* start,
+                                                   const uint16_t* end) {
+  return FindRunEnd(
+      start, end,
+      [](auto v) {
+        return Or(Or(Eq(v, '*'), Eq(v, '\n')), Or(Eq(v, '\r'), IsNonAscii(v)));
+      },
+      [](uint16_t c) {
+        return c == '*' || c == '\n' || c == '\r' || IsNonAscii(c);
+      });
+}
+
+// The body of a multi line comment after a line terminator, which only needs
+// to look for '*'.
+V8_INLINE const uint16_t* SkipUntilStar(const uint16_t* start,
+                                        const uint16_t* end) {
+  return FindRunEnd(
+      start, end, [](auto v) { return Eq(v, '*'); },
+      [](uint16_t c) { return c == '*'; });
+}
+
+// Characters of a string literal which neither terminate it nor start an
+// escape sequence (see ScanFlags::kStringTerminator).
+V8_INLINE const uint16_t* SkipStringChars(const uint16_t* start,
+                                          const uint16_t* end) {
+  return FindRunEnd(
+      start, end,
+      [](auto v) {
+        return Or(Or(Or(Eq(v, '\''), Eq(v, '"')), Eq(v, '\\')),
+                  Or(Or(Eq(v, '\n'), Eq(v, '\r')), IsNonAscii(v)));
+      },
+      [](uint16_t c) {
+        return c == '\'' || c == '"' || c == '\\' || c == '\n' || c == '\r' ||
+               IsNonAscii(c);
+      });
+}
+
+// ASCII identifier parts: letters, digits, '_' and '$'.
+V8_INLINE const uint16_t* SkipIdentifierChars(const uint16_t* start,
+                                              const uint16_t* end) {
+  return FindRunEnd(
+      start, end,
+      [](auto v) {
+        return Not(Or(Or(InRange(AsciiAlphaToLower(v), 'a', 'z'),
+                         InRange(v, '0', '9')),
+                      Or(Eq(v, '_'), Eq(v, '$'))));
+      },
+      [](uint16_t c) { return !IsAsciiIdentifier(c); });
+}
+
+// Keywords only consist of lowercase letters.
+V8_INLINE bool AllLowercaseLetters(const uint16_t* start, const uint16_t* end) {
+  return std::all_of(start, end,
+                     [](uint16_t c) { return base::IsInRange(c, 'a', 'z'); });
+}
+
+}  // namespace scanner_simd
+
 V8_INLINE Token::Value Scanner::ScanIdentifierOrKeywordInner() {
   DCHECK(IsIdentifierStart(c0_));
   bool escaped = false;
@@ -273,6 +445,15 @@ V8_INLINE Token::Value Scanner::ScanIdentifierOrKeywordInner() {
       // Otherwise we'll fall into the slow path after scanning the identifier.
       DCHECK(!IdentifierNeedsSlowPath(scan_flags));
       AddLiteralChar(static_cast<char>(c0_));
+      SkipRun([this, &scan_flags](const uint16_t* start, const uint16_t* end) {
+        const uint16_t* run_end = scanner_simd::SkipIdentifierChars(start, end);
+        next().literal_chars.AddAsciiChars(start, run_end);
+        if (CanBeKeyword(scan_flags) &&
+            !scanner_simd::AllLowercaseLetters(start, run_end)) {
+          scan_flags |= static_cast<uint8_t>(ScanFlags::kCannotBeKeyword);
+        }
+        return run_end;
+      });
       AdvanceUntil([this, &scan_flags](base::uc32 c0) {
         if (V8_UNLIKELY(static_cast<uint32_t>(c0) > kMaxAscii)) {
           // A non-ascii character means we need to drop through to the slow
@@ -326,6 +507,7 @@ V8_INLINE Token::Value Scanner::SkipWhiteSpace() {
   }
 
   // Advance as long as character is a WhiteSpace or LineTerminator.
+  SkipRun(scanner_simd::SkipSpaces);
   base::uc32 hint = ' ';
   AdvanceUntil([this, &hint](base::uc32 c0) {
     if (V8_LIKELY(c0 == hint)) return false;
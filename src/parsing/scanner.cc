@@ -210,6 +210,7 @@ Token::Value Scanner::SkipSingleLineComment() {
   // separately by the lexical grammar and becomes part of the
   // stream of input elements for the syntactic grammar (see
   // ECMA-262, section 7.4).
+  SkipRun(scanner_simd::SkipSingleLineCommentBody);
   AdvanceUntil([](base::uc32 c0) { return unibrow::IsLineTerminator(c0); });
 
   return Token::WHITESPACE;
@@ -277,6 +278,7 @@ Token::Value Scanner::SkipMultiLineComment() {
   // Until we see the first newline, check for * and newline characters.
   if (!next().after_line_terminator) {
     do {
+      SkipRun(scanner_simd::SkipMultiLineCommentBody);
       AdvanceUntil([](base::uc32 c0) {
         if (V8_UNLIKELY(static_cast<uint32_t>(c0) > kMaxAscii)) {
           return unibrow::IsLineTerminator(c0);
@@ -302,6 +304,7 @@ Token::Value Scanner::SkipMultiLineComment() {
 
   // After we've seen newline, simply try to find '*/'.
   while (c0_ != kEndOfInput) {
+    SkipRun(scanner_simd::SkipUntilStar);
     AdvanceUntil([](base::uc32 c0) { return c0 == '*'; });
 
     while (c0_ == '*') {
@@ -456,6 +459,11 @@ Token::Value Scanner::ScanString() {
 
   next().literal_chars.Start();
   while (true) {
+    SkipRun([this](const uint16_t* start, const uint16_t* end) {
+      const uint16_t* run_end = scanner_simd::SkipStringChars(start, end);
+      next().literal_chars.AddAsciiChars(start, run_end);
+      return run_end;
+    });
     AdvanceUntil([this](base::uc32 c0) {
       if (V8_UNLIKELY(static_cast<uint32_t>(c0) > kMaxAscii)) {
         if (V8_UNLIKELY(unibrow::IsStringLiteralLineTerminator(c0))) {
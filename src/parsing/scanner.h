@@ -95,6 +95,22 @@ class Utf16CharacterStream {
     }
   }
 
+  // Advances past a run of code units without returning them, refilling the
+  // buffer as necessary. {skip} is called with the remaining code units of the
+  // buffer and returns the first one that ends the run. It must only skip code
+  // units that the check of a subsequent AdvanceUntil would skip as well, so
+  // that the caller can resume with AdvanceUntil at the end of the run.
+  template <typename FunctionType>
+  V8_INLINE void SkipRun(FunctionType skip) {
+    // The cursor is past the end after a parser error or the end of input.
+    if (V8_UNLIKELY(buffer_cursor_ > buffer_end_)) return;
+    while (true) {
+      buffer_cursor_ = skip(buffer_cursor_, buffer_end_);
+      DCHECK_LE(buffer_cursor_, buffer_end_);
+      if (buffer_cursor_ != buffer_end_ || !ReadBlockChecked(pos())) return;
+    }
+  }
+
   // Go back one by one character in the input stream.
   // This undoes the most recent Advance().
   inline void Back() {
@@ -541,6 +557,14 @@ class V8_EXPORT_PRIVATE Scanner {
     c0_ = source_->AdvanceUntil(check);
   }
 
+  // Skips the run of code units following c0_ for which the vectorized
+  // {skip} does not stop, see Utf16CharacterStream::SkipRun. c0_ is left
+  // unchanged; the caller continues with AdvanceUntil.
+  template <typename FunctionType>
+  V8_INLINE void SkipRun(FunctionType skip) {
+    source_->SkipRun(skip);
+  }
+
   bool CombineSurrogatePair() {
     DCHECK(!unibrow::Utf16::IsLeadSurrogate(kEndOfInput));
     if (unibrow::Utf16::IsLeadSurrogate(c0_)) {
@@ -375,7 +375,8 @@ Object BytecodeBudgetInterruptWithStackCheck(Isolate* isolate,
     }
   }
 
-  isolate->tiering_manager()->OnInterruptTick(function, code_kind);
+  isolate->tiering_manager()->OnInterruptTick(function, code_kind,
+                                              /* from_jump_loop */ true);
   return ReadOnlyRoots(isolate).undefined_value();
 }
 
@@ -386,7 +387,8 @@ Object BytecodeBudgetInterrupt(Isolate* isolate, RuntimeArguments& args,
   Handle<JSFunction> function = args.at<JSFunction>(0);
   TRACE_EVENT0("v8.execute", "V8.BytecodeBudgetInterrupt");
 
-  isolate->tiering_manager()->OnInterruptTick(function, code_kind);
+  isolate->tiering_manager()->OnInterruptTick(function, code_kind,
+                                              /* from_jump_loop */ false);
   return ReadOnlyRoots(isolate).undefined_value();
 }
 
@@ -11,10 +11,13 @@
 #include "src/base/platform/platform.h"
 #include "src/baseline/baseline-batch-compiler.h"
 #include "src/codegen/background-merge-task.h"
+#include "src/codegen/cpu-features.h"
+#include "src/codegen/reloc-info.h"
 #include "src/common/globals.h"
 #include "src/handles/maybe-handles.h"
 #include "src/handles/persistent-handles.h"
 #include "src/heap/heap-inl.h"
+#include "src/heap/memory-chunk-layout.h"
 #include "src/heap/parked-scope.h"
 #include "src/logging/counters-scopes.h"
 #include "src/logging/log.h"
@@ -120,7 +123,10 @@ void CodeSerializer::SerializeObjectImpl(Handle<HeapObject> obj) {
     if (SerializeReadOnlyObjectReference(raw, &sink_)) return;
 
     instance_type = raw.map().instance_type();
-    CHECK(!InstanceTypeChecker::IsInstructionStream(instance_type));
+    // The only code that makes it into the cache is baseline code, see
+    // CanSerializeBaselineCode.
+    CHECK_IMPLIES(InstanceTypeChecker::IsInstructionStream(instance_type),
+                  InstructionStream::cast(raw).kind() == CodeKind::BASELINE);
 
     if (ElideObject(raw)) {
       AllowGarbageCollection allow_gc;
@@ -239,6 +245,13 @@ void CodeSerializer::SerializeObjectImpl(Handle<HeapObject> obj) {
   SerializeGeneric(obj);
 }
 
+bool CodeSerializer::CanSerializeBaselineCode(Code code) const {
+  if (!v8_flags.code_cache_baseline_code) return false;
+  // Large code objects can't be expressed as a SnapshotSpace.
+  return code.instruction_stream().Size() <=
+         MemoryChunkLayout::MaxRegularCodeObjectSize();
+}
+
 void CodeSerializer::SerializeGeneric(Handle<HeapObject> heap_object) {
   // Object has not yet been serialized.  Serialize it here.
   ObjectSerializer serializer(this, heap_object, &sink_);
@@ -296,12 +309,20 @@ void CreateInterpreterDataForDeserializedCode(Isolate* isolate,
 
 class StressOffThreadDeserializeThread final : public base::Thread {
  public:
-  explicit StressOffThreadDeserializeThread(Isolate* isolate,
-                                            AlignedCachedData* cached_data)
+  StressOffThreadDeserializeThread(Isolate* isolate,
+                                   AlignedCachedData* cached_data,
+                                   MaybeHandle<Script> maybe_cached_script)
       : Thread(
             base::Thread::Options("StressOffThreadDeserializeThread", 2 * MB)),
         isolate_(isolate),
-        cached_data_(cached_data) {}
+        cached_data_(cached_data) {
+    // Like an embedder calling SourceTextAvailable, so that the merge into
+    // the cached Script starts on this thread as well.
+    if (Handle<Script> cached_script;
+        maybe_cached_script.ToHandle(&cached_script)) {
+      merge_task_.SetUpOnMainThread(isolate, cached_script);
+    }
+  }
 
   void Run() final {
     LocalIsolate local_isolate(isolate_, ThreadKind::kBackground);
@@ -309,6 +330,11 @@ class StressOffThreadDeserializeThread final : public base::Thread {
     LocalHandleScope handle_scope(&local_isolate);
     off_thread_data_ =
         CodeSerializer::StartDeserializeOffThread(&local_isolate, cached_data_);
+    if (merge_task_.HasPendingBackgroundWork() &&
+        off_thread_data_.HasResult()) {
+      merge_task_.BeginMergeInBackground(
+          &local_isolate, off_thread_data_.GetOnlyScript(local_isolate.heap()));
+    }
   }
 
   MaybeHandle<SharedFunctionInfo> Finalize(Isolate* isolate,
@@ -316,12 +342,13 @@ class StressOffThreadDeserializeThread final : public base::Thread {
                                            ScriptOriginOptions origin_options) {
     return CodeSerializer::FinishOffThreadDeserialize(
         isolate, std::move(off_thread_data_), cached_data_, source,
-        origin_options);
+        origin_options, &merge_task_);
   }
 
  private:
   Isolate* isolate_;
   AlignedCachedData* cached_data_;
+  BackgroundMergeTask merge_task_;
   CodeSerializer::OffThreadDeserializeData off_thread_data_;
 };
 
@@ -388,18 +415,52 @@ void FinalizeDeserialization(Isolate* isolate,
   }
 }
 
-void BaselineBatchCompileIfSparkplugCompiled(Isolate* isolate, Script script) {
-  // Here is main thread, we trigger early baseline compilation only in
-  // concurrent sparkplug and baseline batch compilation mode which consumes
-  // little main thread execution time.
-  if (v8_flags.concurrent_sparkplug && v8_flags.baseline_batch_compilation) {
-    SharedFunctionInfo::ScriptIterator iter(isolate, script);
-    for (SharedFunctionInfo info = iter.Next(); !info.is_null();
-         info = iter.Next()) {
-      if (info.sparkplug_compiled() && CanCompileWithBaseline(isolate, info)) {
-        isolate->baseline_batch_compiler()->EnqueueSFI(info);
-      }
+// Here is main thread, we trigger early baseline compilation only in
+// concurrent sparkplug and baseline batch compilation mode which consumes
+// little main thread execution time.
+bool ShouldBaselineBatchCompile() {
+  return v8_flags.concurrent_sparkplug && v8_flags.baseline_batch_compilation;
+}
+
+bool NeedsBaselineFixup() {
+  return ShouldBaselineBatchCompile() || v8_flags.code_cache_baseline_code;
+}
+
+bool IsBaselineCandidate(SharedFunctionInfo info) {
+  return info.HasBaselineCode() || info.sparkplug_compiled();
+}
+
+bool HasNearBuiltinEntries(Code code) {
+  RelocIterator it(code, RelocInfo::ModeMask(RelocInfo::NEAR_BUILTIN_ENTRY));
+  return !it.done();
+}
+
+void BaselineBatchCompileIfSparkplugCompiled(Isolate* isolate,
+                                             SharedFunctionInfo info) {
+  if (info.HasBaselineCode()) {
+    // Baseline code from the cache is only kept if this isolate could have
+    // compiled it as well (e.g. not while debugging). Its pc-relative builtin
+    // calls can only be resolved with short builtin calls, see
+    // DeserializerRelocInfoVisitor::VisitOffHeapTarget.
+    if (!CanCompileWithBaseline(isolate, info) ||
+        (!isolate->is_short_builtin_calls_enabled() &&
+         HasNearBuiltinEntries(info.baseline_code(kAcquireLoad)))) {
+      info.FlushBaselineCode();
     }
+    return;
+  }
+  if (ShouldBaselineBatchCompile() && info.sparkplug_compiled() &&
+      CanCompileWithBaseline(isolate, info)) {
+    isolate->baseline_batch_compiler()->EnqueueSFI(info);
+  }
+}
+
+void BaselineBatchCompileIfSparkplugCompiled(Isolate* isolate, Script script) {
+  if (!NeedsBaselineFixup()) return;
+  SharedFunctionInfo::ScriptIterator iter(isolate, script);
+  for (SharedFunctionInfo info = iter.Next(); !info.is_null();
+       info = iter.Next()) {
+    BaselineBatchCompileIfSparkplugCompiled(isolate, info);
   }
 }
 
@@ -410,7 +471,8 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
     ScriptOriginOptions origin_options,
     MaybeHandle<Script> maybe_cached_script) {
   if (v8_flags.stress_background_compile) {
-    StressOffThreadDeserializeThread thread(isolate, cached_data);
+    StressOffThreadDeserializeThread thread(isolate, cached_data,
+                                            maybe_cached_script);
     CHECK(thread.Start());
     thread.Join();
     return thread.Finalize(isolate, source, origin_options);
@@ -516,6 +578,22 @@ CodeSerializer::StartDeserializeOffThread(LocalIsolate* local_isolate,
       OffThreadObjectDeserializer::DeserializeSharedFunctionInfo(
           local_isolate, &scd, &result.scripts);
 
+  // Collect the functions which need baseline code fix-ups now, so that the
+  // main thread only has to look at those.
+  if (NeedsBaselineFixup()) {
+    for (Handle<Script> script : result.scripts) {
+      Handle<WeakFixedArray> infos(script->shared_function_infos(),
+                                   local_isolate);
+      SharedFunctionInfo::ScriptIterator iter(infos);
+      for (SharedFunctionInfo info = iter.Next(); !info.is_null();
+           info = iter.Next()) {
+        if (!IsBaselineCandidate(info)) continue;
+        result.baseline_candidates.push_back(
+            local_isolate->heap()->NewPersistentHandle(info));
+      }
+    }
+  }
+
   result.maybe_result =
       local_isolate->heap()->NewPersistentMaybeHandle(local_maybe_result);
   result.persistent_handles = local_isolate->heap()->DetachPersistentHandles();
@@ -576,6 +654,10 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::FinishOffThreadDeserialize(
   DCHECK(data.persistent_handles->Contains(result.location()));
   result = handle(*result, isolate);
 
+  // Only the foreground part of a merge is done here. If the background part
+  // didn't run, e.g. because the embedder didn't call MergeWithExistingScript,
+  // the new Script replaces the cached one instead of doing the whole merge on
+  // the main thread.
   if (background_merge_task &&
       background_merge_task->HasPendingForegroundWork()) {
     Handle<Script> script = handle(Script::cast(result->script()), isolate);
@@ -583,6 +665,10 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::FinishOffThreadDeserialize(
     DCHECK(Script::cast(result->script()).source().StrictEquals(*source));
     DCHECK(isolate->factory()->script_list()->Contains(
         MaybeObject::MakeWeak(MaybeObject::FromObject(result->script()))));
+    // The merge may have moved deserialized functions into the cached Script,
+    // so the candidates collected off-thread don't cover all of them.
+    BaselineBatchCompileIfSparkplugCompiled(isolate,
+                                            Script::cast(result->script()));
   } else {
     // Fix up the source on the script. This should be the only deserialized
     // script, and the off-thread deserializer should have set its source to
@@ -596,12 +682,15 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::FinishOffThreadDeserialize(
     // Fix up the script list to include the newly deserialized script.
     Handle<WeakArrayList> list = isolate->factory()->script_list();
     for (Handle<Script> script : data.scripts) {
-      BaselineBatchCompileIfSparkplugCompiled(isolate, *script);
       DCHECK(data.persistent_handles->Contains(script.location()));
       list = WeakArrayList::AddToEnd(isolate, list,
                                      MaybeObjectHandle::Weak(script));
     }
     isolate->heap()->SetRootScriptList(*list);
+
+    for (Handle<SharedFunctionInfo> info : data.baseline_candidates) {
+      BaselineBatchCompileIfSparkplugCompiled(isolate, *info);
+    }
   }
 
   if (v8_flags.profile_deserialization) {
@@ -619,6 +708,17 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::FinishOffThreadDeserialize(
   return scope.CloseAndEscape(result);
 }
 
+namespace {
+
+// Baseline code is specialized for the CPU features of the machine that
+// produced it. Caches that can't contain baseline code stay portable.
+uint32_t SupportedCPUFeatures() {
+  if (!v8_flags.code_cache_baseline_code) return 0;
+  return static_cast<uint32_t>(CpuFeatures::SupportedFeatures());
+}
+
+}  // namespace
+
 SerializedCodeData::SerializedCodeData(const std::vector<byte>* payload,
                                        const CodeSerializer* cs) {
   DisallowGarbageCollection no_gc;
@@ -638,6 +738,7 @@ SerializedCodeData::SerializedCodeData(const std::vector<byte>* payload,
   SetHeaderValue(kVersionHashOffset, Version::Hash());
   SetHeaderValue(kSourceHashOffset, cs->source_hash());
   SetHeaderValue(kFlagHashOffset, FlagList::Hash());
+  SetHeaderValue(kSupportedCPUFeaturesOffset, SupportedCPUFeatures());
   SetHeaderValue(kPayloadLengthOffset, static_cast<uint32_t>(payload->size()));
 
   // Zero out any padding in the header.
@@ -684,6 +785,10 @@ SerializedCodeSanityCheckResult SerializedCodeData::SanityCheckWithoutSource()
   if (flags_hash != FlagList::Hash()) {
     return SerializedCodeSanityCheckResult::kFlagsMismatch;
   }
+  uint32_t cpu_features = GetHeaderValue(kSupportedCPUFeaturesOffset);
+  if (cpu_features != SupportedCPUFeatures()) {
+    return SerializedCodeSanityCheckResult::kCpuFeaturesMismatch;
+  }
   uint32_t payload_length = GetHeaderValue(kPayloadLengthOffset);
   uint32_t max_payload_length = this->size_ - kHeaderSize;
   if (payload_length > max_payload_length) {
@@ -54,6 +54,7 @@ enum class SerializedCodeSanityCheckResult {
   kMagicNumberMismatch = 1,
   kVersionMismatch = 2,
   kSourceMismatch = 3,
+  kCpuFeaturesMismatch = 4,
   kFlagsMismatch = 5,
   kChecksumMismatch = 6,
   kInvalidHeader = 7,
@@ -71,6 +72,10 @@ class CodeSerializer : public Serializer {
     friend class CodeSerializer;
     MaybeHandle<SharedFunctionInfo> maybe_result;
     std::vector<Handle<Script>> scripts;
+    // SharedFunctionInfos which were compiled with Sparkplug or came with
+    // baseline code, collected off-thread so that the main thread doesn't have
+    // to walk all functions of the script.
+    std::vector<Handle<SharedFunctionInfo>> baseline_candidates;
     std::unique_ptr<PersistentHandles> persistent_handles;
     SerializedCodeSanityCheckResult sanity_check_result;
   };
@@ -110,6 +115,7 @@ class CodeSerializer : public Serializer {
 
  private:
   void SerializeObjectImpl(Handle<HeapObject> o) override;
+  bool CanSerializeBaselineCode(Code code) const override;
 
   DISALLOW_GARBAGE_COLLECTION(no_gc_)
   uint32_t source_hash_;
@@ -123,13 +129,17 @@ class SerializedCodeData : public SerializedData {
   // [1] version hash
   // [2] source hash
   // [3] flag hash
-  // [4] payload length
-  // [5] payload checksum
+  // [4] supported CPU features (only if the payload may contain baseline code)
+  // [5] payload length
+  // [6] payload checksum
   // ...  serialized payload
   static const uint32_t kVersionHashOffset = kMagicNumberOffset + kUInt32Size;
   static const uint32_t kSourceHashOffset = kVersionHashOffset + kUInt32Size;
   static const uint32_t kFlagHashOffset = kSourceHashOffset + kUInt32Size;
-  static const uint32_t kPayloadLengthOffset = kFlagHashOffset + kUInt32Size;
+  static const uint32_t kSupportedCPUFeaturesOffset =
+      kFlagHashOffset + kUInt32Size;
+  static const uint32_t kPayloadLengthOffset =
+      kSupportedCPUFeaturesOffset + kUInt32Size;
   static const uint32_t kChecksumOffset = kPayloadLengthOffset + kUInt32Size;
   static const uint32_t kUnalignedHeaderSize = kChecksumOffset + kUInt32Size;
   static const uint32_t kHeaderSize = POINTER_SIZE_ALIGN(kUnalignedHeaderSize);
@@ -5,9 +5,11 @@
 #include "src/snapshot/deserializer.h"
 
 #include "src/base/logging.h"
+#include "src/base/memory.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/common/assert-scope.h"
 #include "src/common/globals.h"
+#include "src/execution/isolate-utils-inl.h"
 #include "src/execution/isolate.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap-write-barrier-inl.h"
@@ -498,13 +500,15 @@ void Deserializer<IsolateT>::PostProcessNewObject(Handle<Map> map,
     }
   } else if (InstanceTypeChecker::IsCode(instance_type)) {
     auto code = Code::cast(raw_obj);
-    code.init_code_entry_point(main_thread_isolate(), kNullAddress);
+    // Baseline code from the code cache may be deserialized off the main
+    // thread, so don't use main_thread_isolate() here.
+    Isolate* isolate_for_sandbox = GetIsolateForSandbox(code);
+    code.init_code_entry_point(isolate_for_sandbox, kNullAddress);
     if (code.is_off_heap_trampoline()) {
       Address entry = OffHeapInstructionStart(code, code.builtin_id());
-      code.SetEntryPointForOffHeapBuiltin(main_thread_isolate(), entry);
+      code.SetEntryPointForOffHeapBuiltin(isolate_for_sandbox, entry);
     } else {
-      code.UpdateCodeEntryPoint(main_thread_isolate(),
-                                code.instruction_stream());
+      code.UpdateCodeEntryPoint(isolate_for_sandbox, code.instruction_stream());
     }
   } else if (InstanceTypeChecker::IsMap(instance_type)) {
     if (v8_flags.log_maps) {
@@ -595,6 +599,11 @@ Handle<HeapObject> Deserializer<IsolateT>::ReadObject(SnapshotSpace space) {
   DCHECK_NE(source()->Peek(), kRegisterPendingForwardRef);
   Handle<Map> map = Handle<Map>::cast(ReadObject());
 
+  if (V8_UNLIKELY(strings_can_reference_payload_) &&
+      ShouldReferencePayload(space, *map, size_in_bytes)) {
+    return ReadStringReferencingPayload(size_in_tagged);
+  }
+
   AllocationType allocation = SpaceToAllocation(space);
 
   // When sharing a string table, all in-place internalizable and internalized
@@ -694,6 +703,83 @@ Handle<HeapObject> Deserializer<IsolateT>::ReadObject(SnapshotSpace space) {
   return obj;
 }
 
+template <typename IsolateT>
+bool Deserializer<IsolateT>::ShouldReferencePayload(SnapshotSpace space,
+                                                    Map map,
+                                                    int size_in_bytes) {
+  if (space != SnapshotSpace::kOld) return false;
+  if (map != ReadOnlyRoots(isolate()).one_byte_string_map()) return false;
+  if (size_in_bytes <
+      SeqOneByteString::SizeFor(v8_flags.lazy_snapshot_strings_min_length)) {
+    return false;
+  }
+  // The header and characters have to follow the map as a single chunk of raw
+  // data (see Serializer::ObjectSerializer::OutputRawData). This isn't the
+  // case if forward references to the string have to be resolved first.
+  return source_.Peek() == kVariableRawData;
+}
+
+namespace {
+
+// The characters of a string in the snapshot blob, which outlives the isolate.
+class SnapshotPayloadStringResource final
+    : public v8::String::ExternalOneByteStringResource {
+ public:
+  SnapshotPayloadStringResource(const char* data, size_t length)
+      : data_(data), length_(length) {}
+
+  const char* data() const override { return data_; }
+  size_t length() const override { return length_; }
+
+ private:
+  const char* const data_;
+  const size_t length_;
+};
+
+}  // namespace
+
+// Instead of copying the sequential string, create an external string with the
+// same content that references the characters in the payload. Its pages are
+// then only touched once the string is accessed.
+template <>
+Handle<HeapObject> Deserializer<Isolate>::ReadStringReferencingPayload(
+    int size_in_tagged) {
+  CHECK_EQ(kVariableRawData, source_.Get());
+  // The raw data covers the whole string but the map.
+  const int raw_size_in_tagged = source_.GetInt();
+  CHECK_EQ(size_in_tagged - 1, raw_size_in_tagged);
+  const Address string_start =
+      reinterpret_cast<Address>(
+          source_.GetRaw(raw_size_in_tagged * kTaggedSize)) -
+      HeapObject::kHeaderSize;
+  const uint32_t raw_hash_field = base::ReadUnalignedValue<uint32_t>(
+      string_start + Name::kRawHashFieldOffset);
+  const int length =
+      base::ReadUnalignedValue<int32_t>(string_start + String::kLengthOffset);
+  DCHECK_EQ(SeqOneByteString::SizeFor(length), size_in_tagged * kTaggedSize);
+
+  Handle<String> string =
+      isolate()
+          ->factory()
+          ->NewExternalStringFromOneByte(new SnapshotPayloadStringResource(
+              reinterpret_cast<const char*>(string_start +
+                                            SeqOneByteString::kHeaderSize),
+              length))
+          .ToHandleChecked();
+  // Keep the hash unless all strings are rehashed anyway.
+  if (!should_rehash() && Name::IsHashFieldComputed(raw_hash_field)) {
+    string->set_raw_hash_field(raw_hash_field);
+  }
+  back_refs_.push_back(string);
+  return string;
+}
+
+template <>
+Handle<HeapObject> Deserializer<LocalIsolate>::ReadStringReferencingPayload(
+    int size_in_tagged) {
+  UNREACHABLE();
+}
+
 template <typename IsolateT>
 Handle<HeapObject> Deserializer<IsolateT>::ReadMetaMap() {
   const SnapshotSpace space = SnapshotSpace::kReadOnlyHeap;
@@ -719,17 +805,15 @@ Handle<HeapObject> Deserializer<IsolateT>::ReadMetaMap() {
   return obj;
 }
 
+// Baseline code from the code cache can be deserialized off the main thread,
+// hence this works for both Isolate and LocalIsolate.
+template <typename IsolateT>
 class DeserializerRelocInfoVisitor {
  public:
-  DeserializerRelocInfoVisitor(Deserializer<Isolate>* deserializer,
+  DeserializerRelocInfoVisitor(Deserializer<IsolateT>* deserializer,
                                const std::vector<Handle<HeapObject>>* objects)
       : deserializer_(deserializer), objects_(objects), current_object_(0) {}
 
-  DeserializerRelocInfoVisitor(Deserializer<LocalIsolate>* deserializer,
-                               const std::vector<Handle<HeapObject>>* objects) {
-    UNREACHABLE();
-  }
-
   ~DeserializerRelocInfoVisitor() {
     DCHECK_EQ(current_object_, objects_->size());
   }
@@ -741,32 +825,44 @@ class DeserializerRelocInfoVisitor {
   void VisitOffHeapTarget(InstructionStream host, RelocInfo* rinfo);
 
  private:
-  Isolate* isolate() { return deserializer_->isolate(); }
+  IsolateT* isolate() { return deserializer_->isolate(); }
+  // Only used to read state that is immutable after the Isolate was set up,
+  // e.g. the location of the embedded blob.
+  Isolate* main_isolate() {
+    if constexpr (std::is_same_v<IsolateT, LocalIsolate>) {
+      return isolate()->GetMainThreadIsolateUnsafe();
+    } else {
+      return isolate();
+    }
+  }
   SnapshotByteSource& source() { return deserializer_->source_; }
 
-  Deserializer<Isolate>* deserializer_;
+  Deserializer<IsolateT>* deserializer_;
   const std::vector<Handle<HeapObject>>* objects_;
   int current_object_;
 };
 
-void DeserializerRelocInfoVisitor::VisitCodeTarget(InstructionStream host,
-                                                   RelocInfo* rinfo) {
+template <typename IsolateT>
+void DeserializerRelocInfoVisitor<IsolateT>::VisitCodeTarget(
+    InstructionStream host, RelocInfo* rinfo) {
   HeapObject object = *objects_->at(current_object_++);
   rinfo->set_target_address(
       InstructionStream::cast(object).raw_instruction_start());
 }
 
-void DeserializerRelocInfoVisitor::VisitEmbeddedPointer(InstructionStream host,
-                                                        RelocInfo* rinfo) {
+template <typename IsolateT>
+void DeserializerRelocInfoVisitor<IsolateT>::VisitEmbeddedPointer(
+    InstructionStream host, RelocInfo* rinfo) {
   HeapObject object = *objects_->at(current_object_++);
   // Embedded object reference must be a strong one.
-  rinfo->set_target_object(isolate()->heap(), object);
+  rinfo->set_target_object(isolate()->heap()->AsHeap(), object);
 }
 
-void DeserializerRelocInfoVisitor::VisitExternalReference(
+template <typename IsolateT>
+void DeserializerRelocInfoVisitor<IsolateT>::VisitExternalReference(
     InstructionStream host, RelocInfo* rinfo) {
   byte data = source().Get();
-  CHECK_EQ(data, Deserializer<Isolate>::kExternalReference);
+  CHECK_EQ(data, Deserializer<IsolateT>::kExternalReference);
 
   Address address = deserializer_->ReadExternalReferenceCase();
 
@@ -779,10 +875,11 @@ void DeserializerRelocInfoVisitor::VisitExternalReference(
   }
 }
 
-void DeserializerRelocInfoVisitor::VisitInternalReference(
+template <typename IsolateT>
+void DeserializerRelocInfoVisitor<IsolateT>::VisitInternalReference(
     InstructionStream host, RelocInfo* rinfo) {
   byte data = source().Get();
-  CHECK_EQ(data, Deserializer<Isolate>::kInternalReference);
+  CHECK_EQ(data, Deserializer<IsolateT>::kInternalReference);
 
   // Internal reference target is encoded as an offset from code entry.
   int target_offset = source().GetInt();
@@ -797,21 +894,31 @@ void DeserializerRelocInfoVisitor::VisitInternalReference(
       rinfo->pc(), target, rinfo->rmode());
 }
 
-void DeserializerRelocInfoVisitor::VisitOffHeapTarget(InstructionStream host,
-                                                      RelocInfo* rinfo) {
-  // Currently we don't serialize code that contains near builtin entries.
-  DCHECK_NE(rinfo->rmode(), RelocInfo::NEAR_BUILTIN_ENTRY);
-
+template <typename IsolateT>
+void DeserializerRelocInfoVisitor<IsolateT>::VisitOffHeapTarget(
+    InstructionStream host, RelocInfo* rinfo) {
   byte data = source().Get();
-  CHECK_EQ(data, Deserializer<Isolate>::kOffHeapTarget);
+  CHECK_EQ(data, Deserializer<IsolateT>::kOffHeapTarget);
 
   Builtin builtin = Builtins::FromInt(source().GetInt());
 
-  CHECK_NOT_NULL(isolate()->embedded_blob_code());
-  EmbeddedData d = EmbeddedData::FromBlob(isolate());
+  CHECK_NOT_NULL(main_isolate()->embedded_blob_code());
+  EmbeddedData d = EmbeddedData::FromBlob(main_isolate());
   Address address = d.InstructionStartOfBuiltin(builtin);
   CHECK_NE(kNullAddress, address);
 
+  if (RelocInfo::IsNearBuiltinEntry(rinfo->rmode())) {
+    // Only with short builtin calls the embedded blob is guaranteed to be in
+    // pc-relative range of the code. Otherwise the call stays unresolved, and
+    // the code is flushed before it can be used (see
+    // BaselineBatchCompileIfSparkplugCompiled in code-serializer.cc).
+    if (main_isolate()->is_short_builtin_calls_enabled()) {
+      rinfo->set_target_address(address, SKIP_WRITE_BARRIER,
+                                SKIP_ICACHE_FLUSH);
+    }
+    return;
+  }
+
   // TODO(ishell): implement RelocInfo::set_target_off_heap_target()
   if (RelocInfo::OffHeapTargetIsCodedSpecially()) {
     Address location_of_branch_data = rinfo->pc();
@@ -1231,10 +1338,9 @@ int Deserializer<IsolateT>::ReadCodeBody(byte data,
     if (V8_EXTERNAL_CODE_SPACE_BOOL) {
       code.set_main_cage_base(isolate()->cage_base(), kRelaxedStore);
     }
-    DeserializerRelocInfoVisitor visitor(this, &preserialized_objects);
-    for (RelocIterator it(code,
-                          InstructionStream::BodyDescriptor::kRelocModeMask);
-         !it.done(); it.next()) {
+    DeserializerRelocInfoVisitor<IsolateT> visitor(this,
+                                                   &preserialized_objects);
+    for (RelocIterator it(code, CodeRelocModeMask()); !it.done(); it.next()) {
       it.rinfo()->Visit(&visitor);
     }
   }
@@ -1392,8 +1498,7 @@ int Deserializer<IsolateT>::ReadFixedRepeat(byte data,
 template <typename IsolateT>
 Address Deserializer<IsolateT>::ReadExternalReferenceCase() {
   uint32_t reference_id = static_cast<uint32_t>(source_.GetInt());
-  return main_thread_isolate()->external_reference_table()->address(
-      reference_id);
+  return isolate()->external_reference_table()->address(reference_id);
 }
 
 template <typename IsolateT>
@@ -108,11 +108,19 @@ class Deserializer : public SerializerDeserializer {
   bool deserializing_user_code() const { return deserializing_user_code_; }
   bool should_rehash() const { return should_rehash_; }
 
+  // Lets large one-byte strings reference their characters in the payload
+  // instead of copying them (--lazy-snapshot-strings). Only valid if the
+  // payload outlives the isolate.
+  void AllowStringsReferencingPayload() {
+    strings_can_reference_payload_ = true;
+  }
+
   void Rehash();
 
   Handle<HeapObject> ReadObject();
 
  private:
+  template <typename>
   friend class DeserializerRelocInfoVisitor;
   // A circular queue of hot objects. This is added to in the same order as in
   // Serializer::HotObjectsList, but this stores the objects as a vector of
@@ -226,6 +234,8 @@ class Deserializer : public SerializerDeserializer {
 
   Handle<HeapObject> ReadObject(SnapshotSpace space_number);
   Handle<HeapObject> ReadMetaMap();
+  bool ShouldReferencePayload(SnapshotSpace space, Map map, int size_in_bytes);
+  Handle<HeapObject> ReadStringReferencingPayload(int size_in_tagged);
 
   HeapObjectReferenceType GetAndResetNextReferenceType();
 
@@ -286,6 +296,8 @@ class Deserializer : public SerializerDeserializer {
 
   bool next_reference_is_weak_ = false;
 
+  bool strings_can_reference_payload_ = false;
+
   // TODO(6593): generalize rehashing, and remove this flag.
   const bool should_rehash_;
   std::vector<Handle<HeapObject>> to_rehash_;
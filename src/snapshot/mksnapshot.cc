@@ -97,7 +97,8 @@ class SnapshotFileWriter {
   static void WriteSnapshotFileData(
       FILE* fp, const v8::base::Vector<const i::byte>& blob) {
     fprintf(fp,
-            "alignas(kPointerAlignment) static const byte blob_data[] = {\n");
+            "alignas(Snapshot::kReadOnlyPageAlignment) static const byte "
+            "blob_data[] = {\n");
     WriteBinaryContentsAsCArray(fp, blob);
     fprintf(fp, "};\n");
     fprintf(fp, "static const int blob_size = %d;\n", blob.length());
@@ -37,9 +37,18 @@ MaybeHandle<HeapObject> ObjectDeserializer::Deserialize() {
   HandleScope scope(isolate());
   Handle<HeapObject> result;
   {
+    base::Optional<CodePageCollectionMemoryModificationScope> code_allocation;
+    if (v8_flags.code_cache_baseline_code) {
+      code_allocation.emplace(isolate()->heap());
+    }
     result = ReadObject();
     DeserializeDeferredObjects();
-    CHECK(new_code_objects().empty());
+    // The only code in the cache is baseline code.
+    CHECK_IMPLIES(!new_code_objects().empty(),
+                  v8_flags.code_cache_baseline_code);
+    for (Handle<InstructionStream> code : new_code_objects()) {
+      code->FlushICache();
+    }
     LinkAllocationSites();
     CHECK(new_maps().empty());
     WeakenDescriptorArrays();
@@ -109,9 +118,18 @@ MaybeHandle<HeapObject> OffThreadObjectDeserializer::Deserialize(
   LocalHandleScope scope(isolate());
   Handle<HeapObject> result;
   {
+    base::Optional<CodePageCollectionMemoryModificationScope> code_allocation;
+    if (v8_flags.code_cache_baseline_code) {
+      code_allocation.emplace(isolate()->heap()->heap());
+    }
     result = ReadObject();
     DeserializeDeferredObjects();
-    CHECK(new_code_objects().empty());
+    // The only code in the cache is baseline code.
+    CHECK_IMPLIES(!new_code_objects().empty(),
+                  v8_flags.code_cache_baseline_code);
+    for (Handle<InstructionStream> code : new_code_objects()) {
+      code->FlushICache();
+    }
     CHECK(new_allocation_sites().empty());
     CHECK(new_maps().empty());
     WeakenDescriptorArrays();
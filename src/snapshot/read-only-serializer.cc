@@ -99,6 +99,11 @@ void ReadOnlySerializer::FinalizeSerialization() {
       // uninitialized and we do not want to include it in the snapshot.
       size_t page_content_bytes = p->HighWaterMark() - p->area_start();
       sink_.PutInt(page_content_bytes, "page content bytes");
+      // Pad the page contents such that they can be mapped directly from the
+      // snapshot blob, see ReadOnlySpace::InitFromMemoryDump.
+      sink_.PutN(ReadOnlySpace::SnapshotPagePadding(sink_.Position(),
+                                                    p->area_start()),
+                 0, "padding");
 #ifdef MEMORY_SANITIZER
       __msan_check_mem_is_initialized(reinterpret_cast<void*>(p->area_start()),
                                       static_cast<int>(page_content_bytes));
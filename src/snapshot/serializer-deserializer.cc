@@ -4,6 +4,8 @@
 
 #include "src/snapshot/serializer-deserializer.h"
 
+#include "src/codegen/reloc-info.h"
+#include "src/objects/objects-body-descriptors-inl.h"
 #include "src/objects/objects-inl.h"
 
 namespace v8 {
@@ -41,6 +43,11 @@ void SerializerDeserializer::IterateSharedHeapObjectCache(
                      Root::kSharedHeapObjectCache, visitor);
 }
 
+int SerializerDeserializer::CodeRelocModeMask() {
+  return InstructionStream::BodyDescriptor::kRelocModeMask |
+         RelocInfo::ModeMask(RelocInfo::NEAR_BUILTIN_ENTRY);
+}
+
 bool SerializerDeserializer::CanBeDeferred(HeapObject o) {
   // 1. Maps cannot be deferred as objects are expected to have a valid map
   // immediately.
@@ -27,6 +27,11 @@ class SerializerDeserializer : public RootVisitor {
  protected:
   static bool CanBeDeferred(HeapObject o);
 
+  // The RelocInfo modes of an InstructionStream that are serialized. Besides
+  // the ones visited by the GC, these are the pc-relative calls to embedded
+  // builtins, whose targets depend on the embedded blob of the isolate.
+  static int CodeRelocModeMask();
+
   void RestoreExternalReferenceRedirector(Isolate* isolate,
                                           AccessorInfo accessor_info);
   void RestoreExternalReferenceRedirector(Isolate* isolate,
@@ -132,10 +132,8 @@ void Serializer::SerializeObject(Handle<HeapObject> obj) {
     obj = handle(ThinString::cast(*obj).actual(isolate()), isolate());
   } else if (obj->IsCode(isolate())) {
     Code code = Code::cast(*obj);
-    if (code.kind() == CodeKind::BASELINE) {
-      // For now just serialize the BytecodeArray instead of baseline code.
-      // TODO(v8:11429,pthier): Handle Baseline code in cases we want to
-      // serialize it.
+    if (code.kind() == CodeKind::BASELINE && !CanSerializeBaselineCode(code)) {
+      // Serialize the BytecodeArray instead of the baseline code.
       obj = handle(code.bytecode_or_interpreter_data(isolate()), isolate());
     }
   }
@@ -1130,10 +1128,11 @@ void Serializer::ObjectSerializer::VisitOffHeapTarget(InstructionStream host,
                                                       RelocInfo* rinfo) {
   static_assert(EmbeddedData::kTableSize == Builtins::kBuiltinCount);
 
-  // Currently we don't serialize code that contains near builtin entries.
-  CHECK_NE(rinfo->rmode(), RelocInfo::NEAR_BUILTIN_ENTRY);
-
-  Address addr = rinfo->target_off_heap_target();
+  // Near builtin entries are pc-relative, they are resolved against the
+  // embedded blob of the deserializing isolate.
+  Address addr = RelocInfo::IsNearBuiltinEntry(rinfo->rmode())
+                     ? rinfo->target_address()
+                     : rinfo->target_off_heap_target();
   CHECK_NE(kNullAddress, addr);
 
   Builtin builtin = OffHeapInstructionStream::TryLookupCode(isolate(), addr);
@@ -1317,8 +1316,7 @@ void Serializer::ObjectSerializer::SerializeCode(Map map, int size) {
   // TODO(leszeks): We only really need to pre-serialize objects which need
   // serialization, i.e. no backrefs or roots.
   RelocInfoObjectPreSerializer pre_serializer(serializer_);
-  for (RelocIterator it(*on_heap_code, relocation_info,
-                        InstructionStream::BodyDescriptor::kRelocModeMask);
+  for (RelocIterator it(*on_heap_code, relocation_info, CodeRelocModeMask());
        !it.done(); it.next()) {
     it.rinfo()->Visit(&pre_serializer);
   }
@@ -1328,8 +1326,7 @@ void Serializer::ObjectSerializer::SerializeCode(Map map, int size) {
   // Finally serialize all RelocInfo objects in the on-heap InstructionStream,
   // knowing that we will not do a recursive serialization.
   // TODO(leszeks): Add a scope that DCHECKs this.
-  for (RelocIterator it(*on_heap_code, relocation_info,
-                        InstructionStream::BodyDescriptor::kRelocModeMask);
+  for (RelocIterator it(*on_heap_code, relocation_info, CodeRelocModeMask());
        !it.done(); it.next()) {
     it.rinfo()->Visit(this);
   }
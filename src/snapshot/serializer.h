@@ -229,6 +229,10 @@ class Serializer : public SerializerDeserializer {
 
   virtual bool MustBeDeferred(HeapObject object);
 
+  // Baseline code is serialized as its BytecodeArray, unless the serializer
+  // can keep the machine code.
+  virtual bool CanSerializeBaselineCode(Code code) const { return false; }
+
   void VisitRootPointers(Root root, const char* description,
                          FullObjectSlot start, FullObjectSlot end) override;
   void SerializeRootObject(FullObjectSlot slot);
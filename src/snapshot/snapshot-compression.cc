@@ -4,7 +4,13 @@
 
 #include "src/snapshot/snapshot-compression.h"
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "include/v8-platform.h"
 #include "src/base/platform/elapsed-timer.h"
+#include "src/init/v8.h"
 #include "src/utils/memcopy.h"
 #include "src/utils/utils.h"
 #include "third_party/zlib/google/compression_utils_portable.h"
@@ -12,12 +18,80 @@
 namespace v8 {
 namespace internal {
 
-uint32_t GetUncompressedSize(const Bytef* compressed_data) {
-  uint32_t size;
-  MemCopy(&size, compressed_data, sizeof(size));
-  return size;
+namespace {
+
+// The snapshot is split into chunks which are compressed independently, so
+// that they can be decompressed in parallel. The compressed data consists of
+// uint32_t-sized header entries, followed by the chunks as raw deflate streams:
+// [0] uncompressed size
+// [1] uncompressed chunk size; only the last chunk may be smaller
+// [2 ... 2 + number of chunks - 1] compressed size of each chunk
+// ... compressed chunks
+constexpr uint32_t kUncompressedSizeOffset = 0;
+constexpr uint32_t kChunkSizeOffset = kUncompressedSizeOffset + kUInt32Size;
+constexpr uint32_t kCompressedChunkSizesOffset = kChunkSizeOffset + kUInt32Size;
+
+uint32_t ReadUint32(const byte* data) {
+  uint32_t value;
+  MemCopy(&value, data, sizeof(value));
+  return value;
+}
+
+void WriteUint32(byte* data, uint32_t value) {
+  MemCopy(data, &value, sizeof(value));
+}
+
+uint32_t ChunkCount(uint32_t size, uint32_t chunk_size) {
+  return (size + chunk_size - 1) / chunk_size;
+}
+
+uint32_t HeaderSize(uint32_t chunk_count) {
+  return kCompressedChunkSizesOffset + chunk_count * kUInt32Size;
 }
 
+struct Chunk {
+  base::Vector<const byte> compressed;
+  base::Vector<byte> uncompressed;
+};
+
+void DecompressChunk(const Chunk& chunk) {
+  static_assert(sizeof(Bytef) == 1, "");
+  uLongf uncompressed_size = static_cast<uLongf>(chunk.uncompressed.size());
+  CHECK_EQ(zlib_internal::UncompressHelper(
+               zlib_internal::ZRAW,
+               base::bit_cast<Bytef*>(chunk.uncompressed.begin()),
+               &uncompressed_size,
+               base::bit_cast<const Bytef*>(chunk.compressed.begin()),
+               static_cast<uLong>(chunk.compressed.size())),
+           Z_OK);
+  CHECK_EQ(chunk.uncompressed.size(), uncompressed_size);
+}
+
+class DecompressChunksJob final : public JobTask {
+ public:
+  explicit DecompressChunksJob(const std::vector<Chunk>* chunks)
+      : chunks_(chunks) {}
+
+  void Run(JobDelegate* delegate) override {
+    while (!delegate->ShouldYield()) {
+      size_t index = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+      if (index >= chunks_->size()) return;
+      DecompressChunk((*chunks_)[index]);
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t /* worker_count */) const override {
+    size_t next_chunk = next_chunk_.load(std::memory_order_relaxed);
+    return next_chunk < chunks_->size() ? chunks_->size() - next_chunk : 0;
+  }
+
+ private:
+  const std::vector<Chunk>* const chunks_;
+  std::atomic<size_t> next_chunk_{0};
+};
+
+}  // namespace
+
 SnapshotData SnapshotCompression::Compress(
     const SnapshotData* uncompressed_data) {
   SnapshotData snapshot_data;
@@ -25,39 +99,47 @@ SnapshotData SnapshotCompression::Compress(
   if (v8_flags.profile_deserialization) timer.Start();
 
   static_assert(sizeof(Bytef) == 1, "");
-  const uLongf input_size =
-      static_cast<uLongf>(uncompressed_data->RawData().size());
-  uint32_t payload_length =
-      static_cast<uint32_t>(uncompressed_data->RawData().size());
-
-  uLongf compressed_data_size = compressBound(input_size);
+  base::Vector<const byte> input = uncompressed_data->RawData();
+  const uint32_t payload_length = static_cast<uint32_t>(input.size());
+  CHECK_GT(v8_flags.snapshot_compression_chunk_size, 0);
+  const uint32_t chunk_size =
+      static_cast<uint32_t>(v8_flags.snapshot_compression_chunk_size);
+  const uint32_t chunk_count = ChunkCount(payload_length, chunk_size);
 
   // Allocating >= the final amount we will need.
-  snapshot_data.AllocateData(
-      static_cast<uint32_t>(sizeof(payload_length) + compressed_data_size));
+  size_t max_size = HeaderSize(chunk_count);
+  for (uint32_t offset = 0; offset < payload_length; offset += chunk_size) {
+    max_size += compressBound(std::min(chunk_size, payload_length - offset));
+  }
+  snapshot_data.AllocateData(static_cast<uint32_t>(max_size));
 
   byte* compressed_data = const_cast<byte*>(snapshot_data.RawData().begin());
-  // Since we are doing raw compression (no zlib or gzip headers), we need to
-  // manually store the uncompressed size.
-  MemCopy(compressed_data, &payload_length, sizeof(payload_length));
-
-  CHECK_EQ(
-      zlib_internal::CompressHelper(
-          zlib_internal::ZRAW, compressed_data + sizeof(payload_length),
-          &compressed_data_size,
-          base::bit_cast<const Bytef*>(uncompressed_data->RawData().begin()),
-          input_size, Z_DEFAULT_COMPRESSION, nullptr, nullptr),
-      Z_OK);
+  WriteUint32(compressed_data + kUncompressedSizeOffset, payload_length);
+  WriteUint32(compressed_data + kChunkSizeOffset, chunk_size);
+
+  byte* compressed_chunk = compressed_data + HeaderSize(chunk_count);
+  for (uint32_t i = 0; i < chunk_count; i++) {
+    const uint32_t offset = i * chunk_size;
+    const uint32_t length = std::min(chunk_size, payload_length - offset);
+    uLongf compressed_chunk_size = compressBound(length);
+    CHECK_EQ(zlib_internal::CompressHelper(
+                 zlib_internal::ZRAW, compressed_chunk, &compressed_chunk_size,
+                 base::bit_cast<const Bytef*>(input.begin() + offset), length,
+                 Z_DEFAULT_COMPRESSION, nullptr, nullptr),
+             Z_OK);
+    WriteUint32(compressed_data + kCompressedChunkSizesOffset + i * kUInt32Size,
+                static_cast<uint32_t>(compressed_chunk_size));
+    compressed_chunk += compressed_chunk_size;
+  }
 
   // Reallocating to exactly the size we need.
-  snapshot_data.Resize(static_cast<uint32_t>(compressed_data_size) +
-                       sizeof(payload_length));
-  DCHECK_EQ(payload_length,
-            GetUncompressedSize(snapshot_data.RawData().begin()));
+  snapshot_data.Resize(
+      static_cast<uint32_t>(compressed_chunk - compressed_data));
 
   if (v8_flags.profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
-    PrintF("[Compressing %d bytes took %0.3f ms]\n", payload_length, ms);
+    PrintF("[Compressing %d bytes in %d chunks took %0.3f ms]\n",
+           payload_length, chunk_count, ms);
   }
   return snapshot_data;
 }
@@ -68,29 +150,47 @@ SnapshotData SnapshotCompression::Decompress(
   base::ElapsedTimer timer;
   if (v8_flags.profile_deserialization) timer.Start();
 
-  const Bytef* input_bytef =
-      base::bit_cast<const Bytef*>(compressed_data.begin());
-
-  // Since we are doing raw compression (no zlib or gzip headers), we need to
-  // manually retrieve the uncompressed size.
-  uint32_t uncompressed_payload_length = GetUncompressedSize(input_bytef);
-  input_bytef += sizeof(uncompressed_payload_length);
+  const byte* input = compressed_data.begin();
+  const uint32_t uncompressed_payload_length =
+      ReadUint32(input + kUncompressedSizeOffset);
+  const uint32_t chunk_size = ReadUint32(input + kChunkSizeOffset);
+  CHECK_GT(chunk_size, 0);
+  const uint32_t chunk_count =
+      ChunkCount(uncompressed_payload_length, chunk_size);
 
   snapshot_data.AllocateData(uncompressed_payload_length);
-
-  uLongf uncompressed_size = uncompressed_payload_length;
-  CHECK_EQ(zlib_internal::UncompressHelper(
-               zlib_internal::ZRAW,
-               base::bit_cast<Bytef*>(snapshot_data.RawData().begin()),
-               &uncompressed_size, input_bytef,
-               static_cast<uLong>(compressed_data.size() -
-                                  sizeof(uncompressed_payload_length))),
-           Z_OK);
+  byte* output = const_cast<byte*>(snapshot_data.RawData().begin());
+
+  std::vector<Chunk> chunks;
+  chunks.reserve(chunk_count);
+  const byte* compressed_chunk = input + HeaderSize(chunk_count);
+  for (uint32_t i = 0; i < chunk_count; i++) {
+    const uint32_t compressed_chunk_size =
+        ReadUint32(input + kCompressedChunkSizesOffset + i * kUInt32Size);
+    const uint32_t offset = i * chunk_size;
+    chunks.push_back(
+        {base::Vector<const byte>(compressed_chunk, compressed_chunk_size),
+         base::Vector<byte>(output + offset,
+                            std::min(chunk_size,
+                                     uncompressed_payload_length - offset))});
+    compressed_chunk += compressed_chunk_size;
+  }
+  CHECK_EQ(compressed_data.end(), compressed_chunk);
+
+  if (v8_flags.concurrent_snapshot_decompression && chunk_count > 1) {
+    // Wait for all chunks to be decompressed, while participating in the work.
+    V8::GetCurrentPlatform()
+        ->CreateJob(TaskPriority::kUserBlocking,
+                    std::make_unique<DecompressChunksJob>(&chunks))
+        ->Join();
+  } else {
+    for (const Chunk& chunk : chunks) DecompressChunk(chunk);
+  }
 
   if (v8_flags.profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
-    PrintF("[Decompressing %d bytes took %0.3f ms]\n",
-           uncompressed_payload_length, ms);
+    PrintF("[Decompressing %d bytes in %d chunks took %0.3f ms]\n",
+           uncompressed_payload_length, chunk_count, ms);
   }
   return snapshot_data;
 }
@@ -99,6 +99,19 @@ class SnapshotByteSource final {
   // Returns length.
   int GetBlob(const byte** data);
 
+  // Returns a pointer to the next {number_of_bytes} bytes without copying them,
+  // and advances past them.
+  const byte* GetRaw(int number_of_bytes) {
+    DCHECK_LE(position_ + number_of_bytes, length_);
+    const byte* raw = data_ + position_;
+    Advance(number_of_bytes);
+    return raw;
+  }
+
+  base::Vector<const byte> data() const {
+    return base::Vector<const byte>(data_, length_);
+  }
+
   int position() { return position_; }
   void set_position(int position) { position_ = position; }
 
@@ -67,12 +67,14 @@ class SnapshotImpl : public AllStatic {
   // [1] rehashability
   // [2] checksum
   // [3] (64 bytes) version string
-  // [4] offset to readonly
-  // [5] offset to shared heap
-  // [6] offset to context 0
-  // [7] offset to context 1
+  // [4] offset to startup
+  // [5] offset to readonly
+  // [6] offset to shared heap
+  // [7] offset to context 0
+  // [8] offset to context 1
   // ...
   // ... offset to context N - 1
+  // ... padding, see CreateSnapshotBlob
   // ... startup snapshot data
   // ... read-only snapshot data
   // ... shared heap snapshot data
@@ -86,8 +88,10 @@ class SnapshotImpl : public AllStatic {
   static const uint32_t kChecksumOffset = kRehashabilityOffset + kUInt32Size;
   static const uint32_t kVersionStringOffset = kChecksumOffset + kUInt32Size;
   static const uint32_t kVersionStringLength = 64;
-  static const uint32_t kReadOnlyOffsetOffset =
+  static const uint32_t kStartupOffsetOffset =
       kVersionStringOffset + kVersionStringLength;
+  static const uint32_t kReadOnlyOffsetOffset =
+      kStartupOffsetOffset + kUInt32Size;
   static const uint32_t kSharedHeapOffsetOffset =
       kReadOnlyOffsetOffset + kUInt32Size;
   static const uint32_t kFirstContextOffsetOffset =
@@ -102,7 +106,7 @@ class SnapshotImpl : public AllStatic {
         data->raw_size - kChecksumStart);
   }
 
-  static uint32_t StartupSnapshotOffset(int num_contexts) {
+  static uint32_t HeaderSize(int num_contexts) {
     return POINTER_SIZE_ALIGN(kFirstContextOffsetOffset +
                               num_contexts * kInt32Size);
   }
@@ -507,8 +511,22 @@ v8::StartupData SnapshotImpl::CreateSnapshotBlob(
 #endif
 
   uint32_t num_contexts = static_cast<uint32_t>(context_snapshots->size());
-  uint32_t startup_snapshot_offset =
-      SnapshotImpl::StartupSnapshotOffset(num_contexts);
+  uint32_t startup_snapshot_offset = SnapshotImpl::HeaderSize(num_contexts);
+#ifndef V8_SNAPSHOT_COMPRESSION
+  if (V8_STATIC_ROOTS_BOOL) {
+    // Pad the header such that the read-only snapshot payload is aligned. The
+    // read-only page contents within the payload are aligned relative to its
+    // start, which allows mapping them directly from the blob. See
+    // ReadOnlySpace::InitFromMemoryDump.
+    uint32_t read_only_payload_offset =
+        startup_snapshot_offset +
+        static_cast<uint32_t>(startup_snapshot->RawData().length()) +
+        SnapshotData::kHeaderSize;
+    startup_snapshot_offset +=
+        RoundUp(read_only_payload_offset, Snapshot::kReadOnlyPageAlignment) -
+        read_only_payload_offset;
+  }
+#endif  // V8_SNAPSHOT_COMPRESSION
   uint32_t total_length = startup_snapshot_offset;
   total_length += static_cast<uint32_t>(startup_snapshot->RawData().length());
   total_length += static_cast<uint32_t>(read_only_snapshot->RawData().length());
@@ -520,7 +538,7 @@ v8::StartupData SnapshotImpl::CreateSnapshotBlob(
 
   char* data = new char[total_length];
   // Zero out pre-payload data. Part of that is only used for padding.
-  memset(data, 0, SnapshotImpl::StartupSnapshotOffset(num_contexts));
+  memset(data, 0, startup_snapshot_offset);
 
   SnapshotImpl::SetHeaderValue(data, SnapshotImpl::kNumberOfContextsOffset,
                                num_contexts);
@@ -535,6 +553,8 @@ v8::StartupData SnapshotImpl::CreateSnapshotBlob(
                          SnapshotImpl::kVersionStringLength));
 
   // Startup snapshot (isolate-specific data).
+  SnapshotImpl::SetHeaderValue(data, SnapshotImpl::kStartupOffsetOffset,
+                               startup_snapshot_offset);
   uint32_t payload_offset = startup_snapshot_offset;
   uint32_t payload_length =
       static_cast<uint32_t>(startup_snapshot->RawData().length());
@@ -661,8 +681,7 @@ base::Vector<const byte> SnapshotImpl::ExtractStartupData(
     const v8::StartupData* data) {
   DCHECK(Snapshot::SnapshotIsValid(data));
 
-  uint32_t num_contexts = ExtractNumContexts(data);
-  return ExtractData(data, StartupSnapshotOffset(num_contexts),
+  return ExtractData(data, GetHeaderValue(data, kStartupOffsetOffset),
                      GetHeaderValue(data, kReadOnlyOffsetOffset));
 }
 
@@ -5,9 +5,11 @@
 #ifndef V8_SNAPSHOT_SNAPSHOT_H_
 #define V8_SNAPSHOT_SNAPSHOT_H_
 
+#include <algorithm>
 #include <vector>
 
 #include "include/v8-snapshot.h"  // For StartupData.
+#include "src/base/platform/platform.h"
 #include "src/common/assert-scope.h"
 #include "src/common/globals.h"
 
@@ -55,6 +57,16 @@ class Snapshot : public AllStatic {
   V8_EXPORT_PRIVATE static constexpr SerializerFlags kDefaultSerializerFlags =
       {};
 
+  // Alignment of the embedded snapshot blob, and of the read-only page contents
+  // within it (with static roots, relative to the start of the blob). This
+  // allows ReadOnlySpace::InitFromMemoryDump to map the pages directly from the
+  // binary instead of copying them, on OSes which support it. 16 KB also covers
+  // the OS page size of e.g. arm64 macOS.
+  static constexpr size_t kReadOnlyPageAlignment =
+      base::OS::IsRemapPageSupported()
+          ? std::max(kMinExpectedOSPageSize, size_t{16 * KB})
+          : size_t{kPointerAlignment};
+
   // In preparation for serialization, clear data from the given isolate's heap
   // that 1. can be reconstructed and 2. is not suitable for serialization. The
   // `clear_recompilable_data` flag controls whether compiled objects are
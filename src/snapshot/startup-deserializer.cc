@@ -16,9 +16,25 @@
 namespace v8 {
 namespace internal {
 
+bool StartupDeserializer::PayloadIsInSnapshotBlob() {
+  const v8::StartupData* blob = isolate()->snapshot_blob();
+  if (blob == nullptr || blob->data == nullptr) return false;
+  // A decompressed payload is a temporary copy.
+  base::Vector<const byte> payload = source()->data();
+  const byte* blob_start = reinterpret_cast<const byte*>(blob->data);
+  return payload.begin() >= blob_start &&
+         payload.end() <= blob_start + blob->raw_size;
+}
+
 void StartupDeserializer::DeserializeIntoIsolate() {
   HandleScope scope(isolate());
 
+  // The snapshot blob has to outlive the isolate, so large strings can keep
+  // referencing it.
+  if (v8_flags.lazy_snapshot_strings && PayloadIsInSnapshotBlob()) {
+    AllowStringsReferencingPayload();
+  }
+
   // No active threads.
   DCHECK_NULL(isolate()->thread_manager()->FirstThreadStateInUse());
   // No active handles.
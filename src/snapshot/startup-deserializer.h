@@ -24,6 +24,9 @@ class StartupDeserializer final : public Deserializer<Isolate> {
   void DeserializeIntoIsolate();
 
  private:
+  // Whether the payload is part of the isolate's snapshot blob rather than a
+  // temporary copy.
+  bool PayloadIsInSnapshotBlob();
   void FlushICache();
   void LogNewMapEvents();
 };
@@ -913,6 +913,28 @@ void LiftoffAssembler::SpillLocals() {
   }
 }
 
+void LiftoffAssembler::PrepareLoopLocals() {
+  // Leave at least half of the cache registers of each class to the loop body.
+  int gp_budget = kGpCacheRegList.GetNumRegsSet() / 2;
+  int fp_budget = kFpCacheRegList.GetNumRegsSet() / 2;
+  for (uint32_t i = 0; i < num_locals_; ++i) {
+    VarState* slot = &cache_state_.stack_state[i];
+    // Constants are spilled, since the back edge cannot be expected to hold
+    // the same constant. Registers which are also used by other slots are
+    // spilled as well, since the values could diverge within the loop.
+    if (slot->is_reg() && cache_state_.get_use_count(slot->reg()) == 1) {
+      LiftoffRegister reg = slot->reg();
+      int* budget = reg.is_gp() || reg.is_gp_pair() ? &gp_budget : &fp_budget;
+      int num_regs = reg.is_pair() ? 2 : 1;
+      if (*budget >= num_regs) {
+        *budget -= num_regs;
+        continue;
+      }
+    }
+    Spill(slot);
+  }
+}
+
 void LiftoffAssembler::SpillAllRegisters() {
   for (uint32_t i = 0, e = cache_state_.stack_height(); i < e; ++i) {
     auto& slot = cache_state_.stack_state[i];
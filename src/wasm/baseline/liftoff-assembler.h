@@ -656,6 +656,9 @@ class LiftoffAssembler : public TurboAssembler {
 
   void Spill(VarState* slot);
   void SpillLocals();
+  // Spills locals before entering a loop, but keeps as many of them in their
+  // registers as possible without taking too many registers from the loop body.
+  void PrepareLoopLocals();
   void SpillAllRegisters();
   inline void LoadSpillAddress(Register dst, int offset, ValueKind kind);
 
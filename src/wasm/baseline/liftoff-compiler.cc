@@ -1243,12 +1243,12 @@ class LiftoffCompiler {
   void Block(FullDecoder* decoder, Control* block) { PushControl(block); }
 
   void Loop(FullDecoder* decoder, Control* loop) {
-    // Before entering a loop, spill all locals to the stack, in order to free
-    // the cache registers, and to avoid unnecessarily reloading stack values
-    // into registers at branches.
-    // TODO(clemensb): Come up with a better strategy here, involving
-    // pre-analysis of the function.
-    __ SpillLocals();
+    // Before entering a loop, spill locals to the stack, in order to free
+    // cache registers for the loop body, and to avoid unnecessarily reloading
+    // stack values into registers at branches. Locals which are already in
+    // registers stay there as long as enough registers remain for the loop
+    // body; the back edge then moves their values back into these registers.
+    __ PrepareLoopLocals();
 
     __ PrepareLoopArgs(loop->start_merge.arity);
 
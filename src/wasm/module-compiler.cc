@@ -26,6 +26,7 @@
 #include "src/wasm/pgo.h"
 #include "src/wasm/streaming-decoder.h"
 #include "src/wasm/wasm-code-manager.h"
+#include "src/wasm/wasm-disk-cache.h"
 #include "src/wasm/wasm-engine.h"
 #include "src/wasm/wasm-import-wrapper-cache.h"
 #include "src/wasm/wasm-js.h"
@@ -1387,10 +1388,14 @@ void TriggerTierUp(WasmInstanceObject instance, int func_index) {
     int array_index =
         wasm::declared_function_index(instance.module(), func_index);
     instance.tiering_budget_array()[array_index] = v8_flags.wasm_tiering_budget;
-    int& stored_priority =
-        module->type_feedback.feedback_for_function[func_index].tierup_priority;
+    FunctionTypeFeedback& feedback =
+        module->type_feedback.feedback_for_function[func_index];
+    int& stored_priority = feedback.tierup_priority;
     if (stored_priority < kMaxInt) ++stored_priority;
     priority = stored_priority;
+    if (priority == 1 && base::TimeTicks::IsHighResolution()) {
+      feedback.tierup_trigger_time = base::TimeTicks::Now();
+    }
   }
   // Only create a compilation unit if this is the first time we detect this
   // function as hot (priority == 1), or if the priority increased
@@ -1435,6 +1440,20 @@ void RecordStats(Code code, Counters* counters) {
 
 enum CompilationExecutionResult : int8_t { kNoMoreUnits, kYield };
 
+void RecordTierUpLatency(const WasmModule* module, int func_index,
+                         Counters* counters) {
+  base::TimeTicks trigger_time;
+  {
+    base::MutexGuard mutex_guard(&module->type_feedback.mutex);
+    auto it = module->type_feedback.feedback_for_function.find(func_index);
+    if (it == module->type_feedback.feedback_for_function.end()) return;
+    std::swap(trigger_time, it->second.tierup_trigger_time);
+  }
+  if (trigger_time.IsNull()) return;
+  counters->wasm_tier_up_latency()->AddTimedSample(base::TimeTicks::Now() -
+                                                   trigger_time);
+}
+
 CompilationExecutionResult ExecuteJSToWasmWrapperCompilationUnits(
     std::weak_ptr<NativeModule> native_module, JobDelegate* delegate) {
   std::shared_ptr<JSToWasmWrapperCompilationUnit> wrapper_unit = nullptr;
@@ -1578,6 +1597,12 @@ CompilationExecutionResult ExecuteCompilationUnits(
         compile_scope.native_module()->AddLiftoffBailout();
       }
 
+      if (current_tier == ExecutionTier::kTurbofan && !unit->for_debugging() &&
+          compile_scope.compilation_state()->dynamic_tiering()) {
+        RecordTierUpLatency(compile_scope.native_module()->module(),
+                            unit->func_index(), counters);
+      }
+
       // Yield or get next unit.
       if (yield ||
           !(unit = compile_scope.compilation_state()->GetNextCompilationUnit(
@@ -1863,6 +1888,24 @@ void CompileNativeModule(Isolate* isolate,
   }
 }
 
+// Returns how many workers should execute compilation units of
+// {compilation_state} at most.
+size_t MaxCompileConcurrency(CompilationStateImpl* compilation_state) {
+  size_t max_concurrency =
+      static_cast<size_t>(v8_flags.wasm_num_compilation_tasks);
+  // With dynamic tiering, only units of hot functions are left once baseline
+  // compilation finished. Those are not blocking anything, so leave half of
+  // the worker threads to other background work.
+  if (compilation_state->dynamic_tiering() &&
+      compilation_state->baseline_compilation_finished()) {
+    size_t num_worker_threads = static_cast<size_t>(
+        V8::GetCurrentPlatform()->NumberOfWorkerThreads());
+    max_concurrency =
+        std::min(max_concurrency, std::max(size_t{1}, num_worker_threads / 2));
+  }
+  return max_concurrency;
+}
+
 class BackgroundCompileJob final : public JobTask {
  public:
   explicit BackgroundCompileJob(std::weak_ptr<NativeModule> native_module,
@@ -1884,7 +1927,7 @@ class BackgroundCompileJob final : public JobTask {
     // NumOutstandingCompilations() does not reflect the units that running
     // workers are processing, thus add the current worker count to that number.
     return std::min(
-        static_cast<size_t>(v8_flags.wasm_num_compilation_tasks),
+        MaxCompileConcurrency(compile_scope.compilation_state()),
         worker_count +
             compile_scope.compilation_state()->NumOutstandingCompilations());
   }
@@ -1995,8 +2038,8 @@ AsyncCompileJob::AsyncCompileJob(
 }
 
 void AsyncCompileJob::Start() {
-  DoAsync<DecodeModule>(isolate_->counters(),
-                        isolate_->metrics_recorder());  // --
+  DoAsync<DecodeModule>(isolate_->counters(), isolate_->metrics_recorder(),
+                        GetWasmEngine()->disk_cache() != nullptr);  // --
 }
 
 void AsyncCompileJob::Abort() {
@@ -2484,11 +2527,25 @@ void AsyncCompileJob::NextStep(Args&&... args) {
 //==========================================================================
 class AsyncCompileJob::DecodeModule : public AsyncCompileJob::CompileStep {
  public:
-  explicit DecodeModule(Counters* counters,
-                        std::shared_ptr<metrics::Recorder> metrics_recorder)
-      : counters_(counters), metrics_recorder_(std::move(metrics_recorder)) {}
+  DecodeModule(Counters* counters,
+               std::shared_ptr<metrics::Recorder> metrics_recorder,
+               bool lookup_in_disk_cache)
+      : counters_(counters),
+        metrics_recorder_(std::move(metrics_recorder)),
+        lookup_in_disk_cache_(lookup_in_disk_cache) {}
 
   void RunInBackground(AsyncCompileJob* job) override {
+    if (V8_UNLIKELY(lookup_in_disk_cache_)) {
+      // Reading the cache entry is I/O, so it's done here, off the main
+      // thread. Deserialization needs the isolate.
+      std::unique_ptr<WasmDiskCache::Entry> entry =
+          GetWasmEngine()->disk_cache()->Lookup(
+              job->enabled_features_, job->wire_bytes_.module_bytes());
+      if (entry) {
+        job->DoSync<DeserializeFromDiskCache>(std::move(entry));
+        return;
+      }
+    }
     ModuleResult result;
     {
       DisallowHandleAllocation no_handle;
@@ -2530,6 +2587,38 @@ class AsyncCompileJob::DecodeModule : public AsyncCompileJob::CompileStep {
  private:
   Counters* const counters_;
   std::shared_ptr<metrics::Recorder> metrics_recorder_;
+  const bool lookup_in_disk_cache_;
+};
+
+//==========================================================================
+// Step 1b (sync): Deserialize the module from the disk cache.
+//==========================================================================
+class AsyncCompileJob::DeserializeFromDiskCache : public CompileStep {
+ public:
+  explicit DeserializeFromDiskCache(std::unique_ptr<WasmDiskCache::Entry> entry)
+      : entry_(std::move(entry)) {}
+
+ private:
+  void RunInForeground(AsyncCompileJob* job) override {
+    TRACE_COMPILE("(1b) Deserializing module from the disk cache...\n");
+    Handle<WasmModuleObject> module_object;
+    if (!WasmDiskCache::Deserialize(job->isolate_, job->enabled_features_,
+                                    *entry_, job->wire_bytes_.module_bytes())
+             .ToHandle(&module_object)) {
+      // Compile the module after all.
+      job->DoAsync<DecodeModule>(job->isolate_->counters(),
+                                 job->isolate_->metrics_recorder(), false);
+      return;
+    }
+    job->module_object_ =
+        job->isolate_->global_handles()->Create(*module_object);
+    job->native_module_ = job->module_object_->shared_native_module();
+    job->wire_bytes_ = ModuleWireBytes(job->native_module_->wire_bytes());
+    // Calling {FinishCompile} deletes the {AsyncCompileJob} and {this}.
+    job->FinishCompile(false);
+  }
+
+  const std::unique_ptr<WasmDiskCache::Entry> entry_;
 };
 
 //==========================================================================
@@ -3850,21 +3939,42 @@ WasmCode* CompileImportWrapper(
   // Keep the {WasmCode} alive until we explicitly call {IncRef}.
   WasmCodeRefScope code_ref_scope;
   CompilationEnv env = native_module->CreateCompilationEnv();
-  WasmCompilationResult result = compiler::CompileWasmImportCallWrapper(
-      &env, kind, sig, source_positions, expected_arity, suspend);
+  // Wrappers only depend on the canonical signature and the enabled features,
+  // so other modules can reuse them. Wrappers of asm.js modules contain source
+  // positions and are not shared.
+  SharedImportWrapperCache* shared_cache =
+      v8_flags.wasm_shared_import_wrappers && !source_positions
+          ? GetWasmEngine()->shared_import_wrapper_cache()
+          : nullptr;
+  std::shared_ptr<const WasmCompilationResult> result;
+  if (shared_cache) result = shared_cache->MaybeGet(key, env.enabled_features);
+  bool reused = result != nullptr;
+  if (!reused) {
+    WasmCompilationResult compiled = compiler::CompileWasmImportCallWrapper(
+        &env, kind, sig, source_positions, expected_arity, suspend);
+    result = shared_cache ? shared_cache->Insert(key, env.enabled_features,
+                                                 std::move(compiled))
+                          : std::make_shared<const WasmCompilationResult>(
+                                std::move(compiled));
+  }
   WasmCode* published_code;
   {
     CodeSpaceWriteScope code_space_write_scope(native_module);
     std::unique_ptr<WasmCode> wasm_code = native_module->AddCode(
-        result.func_index, result.code_desc, result.frame_slot_count,
-        result.tagged_parameter_slots,
-        result.protected_instructions_data.as_vector(),
-        result.source_positions.as_vector(), GetCodeKind(result),
+        result->func_index, result->code_desc, result->frame_slot_count,
+        result->tagged_parameter_slots,
+        result->protected_instructions_data.as_vector(),
+        result->source_positions.as_vector(), GetCodeKind(*result),
         ExecutionTier::kNone, kNotForDebugging);
     published_code = native_module->PublishCode(std::move(wasm_code));
   }
   (*cache_scope)[key] = published_code;
   published_code->IncRef();
+  if (reused) {
+    counters->wasm_reused_import_wrappers()->Increment();
+    counters->wasm_reused_import_wrapper_size()->Increment(
+        published_code->instructions().length());
+  }
   counters->wasm_generated_code_size()->Increment(
       published_code->instructions().length());
   counters->wasm_reloc_size()->Increment(published_code->reloc_info().length());
@@ -162,10 +162,16 @@ class AsyncCompileJob {
 
   // States of the AsyncCompileJob.
   // Step 1 (async). Decodes the wasm module.
+  // --> DeserializeFromDiskCache on disk cache hit,
   // --> Fail on decoding failure,
   // --> PrepareAndStartCompile on success.
   class DecodeModule;
 
+  // Step 1b (sync). Deserializes the module from a disk cache entry.
+  // --> finish directly on success,
+  // --> DecodeModule (without disk cache lookup) on failure.
+  class DeserializeFromDiskCache;
+
   // Step 2 (sync). Prepares runtime objects and starts background compilation.
   // --> finish directly on native module cache hit,
   // --> finish directly on validation error,
@@ -9,6 +9,7 @@
 #ifndef V8_WASM_MODULE_DECODER_IMPL_H_
 #define V8_WASM_MODULE_DECODER_IMPL_H_
 
+#include "include/v8-platform.h"
 #include "src/base/platform/wrappers.h"
 #include "src/logging/counters.h"
 #include "src/strings/unicode.h"
@@ -419,6 +420,11 @@ class ModuleDecoderImpl : public Decoder {
 
     if (!CheckSectionOrder(section_code)) return;
 
+    if (V8_UNLIKELY(validating_functions_ &&
+                    !CanDecodeWhileValidatingFunctions(section_code))) {
+      WaitForFunctionValidation();
+    }
+
     switch (section_code) {
       case kUnknownSectionCode:
         break;
@@ -1626,6 +1632,67 @@ class ModuleDecoderImpl : public Decoder {
                                base::VectorOf(start_, end_ - start_), nullptr);
   }
 
+  // Starts validating all functions in the background, such that validation
+  // overlaps with decoding the sections after the code section.
+  void StartValidatingFunctions(base::Vector<const byte> wire_bytes) {
+    DCHECK(!validating_functions_);
+    DCHECK(validation_error_.empty());
+    validating_functions_ = true;
+    // Pass nullptr for an "empty" filter function.
+    validate_functions_job_ =
+        StartValidateFunctions(module_.get(), enabled_features_, wire_bytes,
+                               nullptr, &validation_error_);
+  }
+
+  // Background function validation reads {module_} without synchronization,
+  // so while it runs, the decoder may only write the parts of {module_} that
+  // validation never reads. These are the parts written by the sections
+  // below, which can all follow the code section.
+  static bool CanDecodeWhileValidatingFunctions(SectionCode section_code) {
+    switch (section_code) {
+      case kUnknownSectionCode:
+      case kDataSectionCode:
+      case kNameSectionCode:
+      case kSourceMappingURLSectionCode:
+      case kDebugInfoSectionCode:
+      case kExternalDebugInfoSectionCode:
+      case kInstTraceSectionCode:
+      case kCompilationHintsSectionCode:
+      case kBranchHintsSectionCode:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // Waits for background validation to finish before writing a part of
+  // {module_} that it reads. The result is picked up by
+  // {FinishValidatingFunctions}.
+  void WaitForFunctionValidation() {
+    if (!validating_functions_ || !validate_functions_job_) return;
+    validate_functions_job_->Join();
+    validate_functions_job_.reset();
+  }
+
+  // Waits for background validation to finish. Since functions only get
+  // validated after all previous sections were decoded successfully, a
+  // decoding error always takes precedence over a validation error.
+  void FinishValidatingFunctions() {
+    if (!validating_functions_) return;
+    validating_functions_ = false;
+    if (validate_functions_job_) {
+      if (ok()) {
+        validate_functions_job_->Join();
+      } else {
+        validate_functions_job_->Cancel();
+      }
+      validate_functions_job_.reset();
+    }
+    if (ok() && validation_error_.has_error()) {
+      error_ = std::move(validation_error_);
+    }
+  }
+
   // Decodes an entire module.
   ModuleResult DecodeModule(bool validate_functions) {
     base::Vector<const byte> wire_bytes(start_, end_ - start_);
@@ -1651,6 +1718,10 @@ class ModuleDecoderImpl : public Decoder {
       if (section_iter.section_code() != SectionCode::kUnknownSectionCode) {
         DecodeSection(section_iter.section_code(), section_iter.payload(),
                       offset);
+        if (validate_functions && ok() &&
+            section_iter.section_code() == kCodeSectionCode) {
+          StartValidatingFunctions(wire_bytes);
+        }
       }
       // Shift the offset by the remaining section payload.
       offset += section_iter.payload_length();
@@ -1658,7 +1729,10 @@ class ModuleDecoderImpl : public Decoder {
       section_iter.advance(true);
     }
 
-    if (ok() && validate_functions) {
+    if (decoder.failed() && ok()) error_ = decoder.error();
+    if (validating_functions_) {
+      FinishValidatingFunctions();
+    } else if (ok() && validate_functions) {
       Reset(wire_bytes);
       ValidateAllFunctions();
     }
@@ -2043,6 +2117,10 @@ class ModuleDecoderImpl : public Decoder {
     }
 #undef TYPE_CHECK
 
+    // The full decoder marks referenced functions as declared, which
+    // background function validation could observe.
+    WaitForFunctionValidation();
+
     auto sig = FixedSizeSignature<ValueType>::Returns(expected);
     FunctionBody body(&sig, buffer_offset_, pc_, end_);
     WasmFeatures detected;
@@ -2403,6 +2481,13 @@ class ModuleDecoderImpl : public Decoder {
   AccountingAllocator allocator_;
   Zone init_expr_zone_{&allocator_, "constant expr. zone"};
 
+  // Set while functions are being validated in the background during
+  // {DecodeModule}; {validate_functions_job_} is nullptr if that validation
+  // already finished.
+  bool validating_functions_ = false;
+  std::unique_ptr<JobHandle> validate_functions_job_;
+  WasmError validation_error_;
+
   // Instruction traces are decoded in DecodeInstTraceSection as a 3-tuple
   // of the function index, function offset, and mark_id. In DecodeCodeSection,
   // after the functions have been decoded this is translated to pairs of module
@@ -464,10 +464,10 @@ class ValidateFunctionsTask : public JobTask {
 };
 }  // namespace
 
-WasmError ValidateFunctions(const WasmModule* module,
-                            WasmFeatures enabled_features,
-                            base::Vector<const uint8_t> wire_bytes,
-                            std::function<bool(int)> filter) {
+std::unique_ptr<JobHandle> StartValidateFunctions(
+    const WasmModule* module, WasmFeatures enabled_features,
+    base::Vector<const uint8_t> wire_bytes, std::function<bool(int)> filter,
+    WasmError* error_out) {
   DCHECK_EQ(kWasmOrigin, module->origin);
 
   class NeverYieldDelegate final : public JobDelegate {
@@ -480,24 +480,31 @@ WasmError ValidateFunctions(const WasmModule* module,
   };
 
   // Create a {ValidateFunctionsTask} to validate all functions. The earliest
-  // error found will be set on this decoder.
-  WasmError validation_error;
+  // error found will be written to {error_out}.
   std::unique_ptr<JobTask> validate_job =
       std::make_unique<ValidateFunctionsTask>(
-          wire_bytes, module, enabled_features, std::move(filter),
-          &validation_error);
+          wire_bytes, module, enabled_features, std::move(filter), error_out);
 
   if (v8_flags.single_threaded) {
     // In single-threaded mode, run the {ValidateFunctionsTask} synchronously.
     NeverYieldDelegate delegate;
     validate_job->Run(&delegate);
-  } else {
-    // Spawn the task and join it.
-    std::unique_ptr<JobHandle> job_handle = V8::GetCurrentPlatform()->CreateJob(
-        TaskPriority::kUserVisible, std::move(validate_job));
-    job_handle->Join();
+    return {};
   }
+  return V8::GetCurrentPlatform()->PostJob(TaskPriority::kUserVisible,
+                                           std::move(validate_job));
+}
 
+WasmError ValidateFunctions(const WasmModule* module,
+                            WasmFeatures enabled_features,
+                            base::Vector<const uint8_t> wire_bytes,
+                            std::function<bool(int)> filter) {
+  WasmError validation_error;
+  std::unique_ptr<JobHandle> job_handle =
+      StartValidateFunctions(module, enabled_features, wire_bytes,
+                             std::move(filter), &validation_error);
+  // Join the job, participating in the validation.
+  if (job_handle) job_handle->Join();
   return validation_error;
 }
 
@@ -20,6 +20,9 @@
 #include "src/wasm/wasm-result.h"
 
 namespace v8 {
+
+class JobHandle;
+
 namespace internal {
 
 class Counters;
@@ -145,6 +148,15 @@ V8_EXPORT_PRIVATE WasmError ValidateFunctions(
     const WasmModule*, WasmFeatures enabled_features,
     base::Vector<const uint8_t> wire_bytes, std::function<bool(int)> filter);
 
+// Like {ValidateFunctions}, but only starts the validation on background
+// threads. The earliest error is written to {error_out} once the returned job
+// is joined; until then, {error_out}, {module} and {wire_bytes} need to stay
+// alive. Returns nullptr if validation already finished synchronously.
+V8_EXPORT_PRIVATE std::unique_ptr<JobHandle> StartValidateFunctions(
+    const WasmModule* module, WasmFeatures enabled_features,
+    base::Vector<const uint8_t> wire_bytes, std::function<bool(int)> filter,
+    WasmError* error_out);
+
 WasmError GetWasmErrorWithName(base::Vector<const uint8_t> wire_bytes,
                                int func_index, const WasmModule* module,
                                WasmError error);
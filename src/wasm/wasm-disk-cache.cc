@@ -0,0 +1,278 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/wasm/wasm-disk-cache.h"
+
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+#include "src/base/functional.h"
+#include "src/base/memory.h"
+#include "src/base/platform/time.h"
+#include "src/base/platform/wrappers.h"
+#include "src/codegen/cpu-features.h"
+#include "src/init/v8.h"
+#include "src/tracing/trace-event.h"
+#include "src/wasm/compilation-environment.h"
+#include "src/wasm/wasm-code-manager.h"
+#include "src/wasm/wasm-engine.h"
+#include "src/wasm/wasm-module.h"
+#include "src/wasm/wasm-serialization.h"
+
+namespace v8::internal::wasm {
+
+namespace {
+
+// The wire bytes file of an entry consists of:
+// [0] magic number
+// [1] size of the wire bytes
+// [2..3] generation
+// ... wire bytes
+constexpr uint32_t kWireBytesMagicNumber = 0x57445357;  // "WSDW"
+constexpr size_t kWireBytesSizeOffset = kUInt32Size;
+constexpr size_t kWireBytesGenerationOffset = 2 * kUInt32Size;
+constexpr size_t kWireBytesHeaderSize = 4 * kUInt32Size;
+
+// The code file of an entry consists of:
+// [0] magic number
+// [1] unused
+// [2..3] generation, matching the one of the wire bytes file
+// ... serialized module (see {WasmSerializer})
+constexpr uint32_t kCodeMagicNumber = 0x43445357;  // "WSDC"
+constexpr size_t kCodeGenerationOffset = 2 * kUInt32Size;
+constexpr size_t kCodeHeaderSize = 4 * kUInt32Size;
+
+std::unique_ptr<base::OS::MemoryMappedFile> OpenFile(const std::string& path) {
+  return std::unique_ptr<base::OS::MemoryMappedFile>(
+      base::OS::MemoryMappedFile::open(
+          path.c_str(), base::OS::MemoryMappedFile::FileMode::kReadOnly));
+}
+
+base::Vector<const uint8_t> FileContents(base::OS::MemoryMappedFile* file) {
+  return {static_cast<const uint8_t*>(file->memory()), file->size()};
+}
+
+// Returns the generation of the wire bytes file at {path}, if it holds
+// {wire_bytes}.
+base::Optional<uint64_t> ReadWireBytesGeneration(
+    const std::string& path, base::Vector<const uint8_t> wire_bytes) {
+  std::unique_ptr<base::OS::MemoryMappedFile> file = OpenFile(path);
+  if (!file) return {};
+  base::Vector<const uint8_t> contents = FileContents(file.get());
+  if (contents.size() != kWireBytesHeaderSize + wire_bytes.size()) return {};
+  Address header = reinterpret_cast<Address>(contents.begin());
+  if (base::ReadUnalignedValue<uint32_t>(header) != kWireBytesMagicNumber ||
+      base::ReadUnalignedValue<uint32_t>(header + kWireBytesSizeOffset) !=
+          wire_bytes.size()) {
+    return {};
+  }
+  if (memcmp(contents.begin() + kWireBytesHeaderSize, wire_bytes.begin(),
+             wire_bytes.size()) != 0) {
+    return {};
+  }
+  return base::ReadUnalignedValue<uint64_t>(header +
+                                            kWireBytesGenerationOffset);
+}
+
+uint64_t NewGeneration() {
+  static std::atomic<uint32_t> next_id{0};
+  // Distinct for all writers in this process, and (with high probability)
+  // from those of other processes.
+  return base::hash_combine(
+      static_cast<size_t>(base::OS::GetCurrentProcessId()),
+      static_cast<size_t>(base::Time::Now().ToInternalValue()),
+      static_cast<size_t>(next_id.fetch_add(1, std::memory_order_relaxed)));
+}
+
+// Writes to a fresh temporary file first, and renames it into place, so that
+// concurrent readers (also in other processes) never see partial files.
+bool WriteFile(const std::string& path, const std::vector<uint8_t>& contents) {
+  static std::atomic<uint32_t> next_temp_id{0};
+  base::EmbeddedVector<char, 32> suffix;
+  SNPrintF(suffix, ".%d.%u.tmp", base::OS::GetCurrentProcessId(),
+           next_temp_id.fetch_add(1, std::memory_order_relaxed));
+  std::string temp_path = path + suffix.begin();
+  FILE* file = base::OS::FOpen(temp_path.c_str(), "wb");
+  if (!file) return false;
+  bool success =
+      fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+  success &= base::Fclose(file) == 0;
+  if (success && std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    // Windows doesn't replace existing files on rename.
+    base::OS::Remove(path.c_str());
+    success = std::rename(temp_path.c_str(), path.c_str()) == 0;
+  }
+  if (!success) base::OS::Remove(temp_path.c_str());
+  return success;
+}
+
+void StoreEntry(const std::string& directory, NativeModule* native_module) {
+  TRACE_EVENT0("v8.wasm", "wasm.StoreToDiskCache");
+  WasmSerializer serializer(native_module);
+  size_t data_size = serializer.GetSerializedNativeModuleSize();
+  std::vector<uint8_t> code(kCodeHeaderSize + data_size);
+  if (!serializer.SerializeNativeModule(
+          base::VectorOf(code.data() + kCodeHeaderSize, data_size))) {
+    return;
+  }
+
+  base::Vector<const uint8_t> wire_bytes = native_module->wire_bytes();
+  std::string path = WasmDiskCache::EntryPath(
+      directory, native_module->enabled_features(), wire_bytes);
+  std::string wire_bytes_path = path + WasmDiskCache::kWireBytesSuffix;
+  // The wire bytes only need to be written once per entry.
+  base::Optional<uint64_t> generation =
+      ReadWireBytesGeneration(wire_bytes_path, wire_bytes);
+  if (!generation.has_value()) {
+    generation = NewGeneration();
+    std::vector<uint8_t> contents(kWireBytesHeaderSize + wire_bytes.size());
+    Address header = reinterpret_cast<Address>(contents.data());
+    base::WriteUnalignedValue<uint32_t>(header, kWireBytesMagicNumber);
+    base::WriteUnalignedValue<uint32_t>(
+        header + kWireBytesSizeOffset,
+        static_cast<uint32_t>(wire_bytes.size()));
+    base::WriteUnalignedValue<uint64_t>(header + kWireBytesGenerationOffset,
+                                        *generation);
+    memcpy(contents.data() + kWireBytesHeaderSize, wire_bytes.begin(),
+           wire_bytes.size());
+    if (!WriteFile(wire_bytes_path, contents)) return;
+  }
+
+  Address header = reinterpret_cast<Address>(code.data());
+  base::WriteUnalignedValue<uint32_t>(header, kCodeMagicNumber);
+  base::WriteUnalignedValue<uint64_t>(header + kCodeGenerationOffset,
+                                      *generation);
+  WriteFile(path + WasmDiskCache::kCodeSuffix, code);
+}
+
+class StoreTask final : public v8::Task {
+ public:
+  StoreTask(std::weak_ptr<NativeModule> native_module, std::string directory,
+            std::shared_ptr<std::atomic<bool>> store_pending)
+      : native_module_(std::move(native_module)),
+        directory_(std::move(directory)),
+        store_pending_(std::move(store_pending)),
+        engine_barrier_(GetWasmEngine()->GetBarrierForBackgroundCompile()) {}
+
+  void Run() override {
+    // Reset first, so that code finished from now on triggers another store.
+    store_pending_->store(false, std::memory_order_relaxed);
+    auto engine_scope = engine_barrier_->TryLock();
+    if (!engine_scope) return;
+    std::shared_ptr<NativeModule> native_module = native_module_.lock();
+    if (!native_module) return;
+    StoreEntry(directory_, native_module.get());
+  }
+
+ private:
+  const std::weak_ptr<NativeModule> native_module_;
+  const std::string directory_;
+  const std::shared_ptr<std::atomic<bool>> store_pending_;
+  const std::shared_ptr<OperationsBarrier> engine_barrier_;
+};
+
+class StoreToDiskCacheCallback final : public CompilationEventCallback {
+ public:
+  StoreToDiskCacheCallback(std::weak_ptr<NativeModule> native_module,
+                           std::string directory)
+      : native_module_(std::move(native_module)),
+        directory_(std::move(directory)) {}
+
+  void call(CompilationEvent event) override {
+    // Without dynamic tiering, baseline compilation already produces top-tier
+    // code. With dynamic tiering, Liftoff code is not serialized anyway, so
+    // only tiered-up chunks are worth storing.
+    if (event != CompilationEvent::kFinishedCompilationChunk &&
+        (event != CompilationEvent::kFinishedBaselineCompilation ||
+         v8_flags.wasm_dynamic_tiering)) {
+      return;
+    }
+    // A pending store will serialize the latest code anyway, including that of
+    // all chunks finishing until it runs.
+    if (store_pending_->exchange(true, std::memory_order_relaxed)) return;
+    V8::GetCurrentPlatform()->CallDelayedOnWorkerThread(
+        std::make_unique<StoreTask>(native_module_, directory_,
+                                    store_pending_),
+        v8_flags.wasm_disk_cache_write_delay / 1000.0);
+  }
+
+  ReleaseAfterFinalEvent release_after_final_event() override {
+    return kKeepAfterFinalEvent;
+  }
+
+ private:
+  const std::weak_ptr<NativeModule> native_module_;
+  const std::string directory_;
+  const std::shared_ptr<std::atomic<bool>> store_pending_ =
+      std::make_shared<std::atomic<bool>>(false);
+};
+
+}  // namespace
+
+// static
+std::string WasmDiskCache::EntryPath(const std::string& directory,
+                                     const WasmFeatures& enabled,
+                                     base::Vector<const uint8_t> wire_bytes) {
+  base::EmbeddedVector<char, 64> filename;
+  SNPrintF(filename, "/wasm-%016zx-%08x-%08x", GetWireBytesHash(wire_bytes),
+           static_cast<uint32_t>(enabled.ToIntegral()),
+           CpuFeatures::SupportedFeatures());
+  return directory + filename.begin();
+}
+
+std::unique_ptr<WasmDiskCache::Entry> WasmDiskCache::Lookup(
+    const WasmFeatures& enabled, base::Vector<const uint8_t> wire_bytes) const {
+  TRACE_EVENT0("v8.wasm", "wasm.LookupInDiskCache");
+  std::string path = EntryPath(enabled, wire_bytes);
+  base::Optional<uint64_t> generation =
+      ReadWireBytesGeneration(path + kWireBytesSuffix, wire_bytes);
+  if (!generation.has_value()) return {};
+
+  std::unique_ptr<base::OS::MemoryMappedFile> file =
+      OpenFile(path + kCodeSuffix);
+  if (!file) return {};
+  base::Vector<const uint8_t> contents = FileContents(file.get());
+  if (contents.size() <= kCodeHeaderSize) return {};
+  Address header = reinterpret_cast<Address>(contents.begin());
+  if (base::ReadUnalignedValue<uint32_t>(header) != kCodeMagicNumber ||
+      base::ReadUnalignedValue<uint64_t>(header + kCodeGenerationOffset) !=
+          *generation) {
+    return {};
+  }
+  return std::unique_ptr<Entry>(
+      new Entry(std::move(file), contents.SubVectorFrom(kCodeHeaderSize)));
+}
+
+// static
+MaybeHandle<WasmModuleObject> WasmDiskCache::Deserialize(
+    Isolate* isolate, const WasmFeatures& enabled, const Entry& entry,
+    base::Vector<const uint8_t> wire_bytes) {
+  // Deserialized modules always use the isolate's features.
+  if (enabled != WasmFeatures::FromIsolate(isolate)) return {};
+  TRACE_EVENT0("v8.wasm", "wasm.DeserializeFromDiskCache");
+  return DeserializeNativeModule(isolate, entry.serialized_module(), wire_bytes,
+                                 {});
+}
+
+MaybeHandle<WasmModuleObject> WasmDiskCache::Load(
+    Isolate* isolate, const WasmFeatures& enabled,
+    base::Vector<const uint8_t> wire_bytes) {
+  if (enabled != WasmFeatures::FromIsolate(isolate)) return {};
+  std::unique_ptr<Entry> entry = Lookup(enabled, wire_bytes);
+  if (!entry) return {};
+  return Deserialize(isolate, enabled, *entry, wire_bytes);
+}
+
+void WasmDiskCache::Track(const std::shared_ptr<NativeModule>& native_module) {
+  if (native_module->module()->origin != kWasmOrigin) return;
+  native_module->compilation_state()->AddCallback(
+      std::make_unique<StoreToDiskCacheCallback>(native_module, directory_));
+}
+
+void WasmDiskCache::Store(NativeModule* native_module) const {
+  StoreEntry(directory_, native_module);
+}
+
+}  // namespace v8::internal::wasm
@@ -0,0 +1,116 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if !V8_ENABLE_WEBASSEMBLY
+#error This header should only be included if WebAssembly is enabled.
+#endif  // !V8_ENABLE_WEBASSEMBLY
+
+#ifndef V8_WASM_WASM_DISK_CACHE_H_
+#define V8_WASM_WASM_DISK_CACHE_H_
+
+#include <memory>
+#include <string>
+
+#include "src/base/platform/platform.h"
+#include "src/base/vector.h"
+#include "src/handles/maybe-handles.h"
+#include "src/wasm/wasm-features.h"
+
+namespace v8::internal {
+
+class Isolate;
+class WasmModuleObject;
+
+namespace wasm {
+
+class NativeModule;
+
+// An engine-wide, opt-in cache of serialized {NativeModule}s in a directory on
+// disk (--wasm-disk-cache-dir). Unlike the {NativeModuleCache}, it survives the
+// process, so that modules don't need to be recompiled on every start.
+//
+// Entries are keyed by the hash of the wire bytes, the enabled features and
+// the supported CPU features; V8 version and flag hash are checked by the
+// serialized data itself. Each entry consists of two files:
+// - the wire bytes, which are written only once, and compared on lookup so
+//   that hash collisions can't result in wrong code, and
+// - the serialized code, which is re-written as the module tiers up (see
+//   {CompilationEvent::kFinishedCompilationChunk}). Writes are delayed by
+//   --wasm-disk-cache-write-delay, so that chunks finishing in quick
+//   succession are written only once.
+// Both files carry a generation number, picked anew whenever the wire bytes
+// file is (re-)written, so that code is never combined with the wire bytes of
+// another module. Files are written to a temporary file first and renamed
+// into place, so readers (which memory-map them) always see complete files.
+class V8_EXPORT_PRIVATE WasmDiskCache {
+ public:
+  // The serialized code of an entry that matched the wire bytes it was looked
+  // up for.
+  class Entry {
+   public:
+    base::Vector<const uint8_t> serialized_module() const {
+      return serialized_module_;
+    }
+
+   private:
+    friend class WasmDiskCache;
+
+    Entry(std::unique_ptr<base::OS::MemoryMappedFile> file,
+          base::Vector<const uint8_t> serialized_module)
+        : file_(std::move(file)), serialized_module_(serialized_module) {}
+
+    const std::unique_ptr<base::OS::MemoryMappedFile> file_;
+    const base::Vector<const uint8_t> serialized_module_;
+  };
+
+  static constexpr char kWireBytesSuffix[] = ".wire";
+  static constexpr char kCodeSuffix[] = ".code";
+
+  explicit WasmDiskCache(const char* directory) : directory_(directory) {}
+
+  WasmDiskCache(const WasmDiskCache&) = delete;
+  WasmDiskCache& operator=(const WasmDiskCache&) = delete;
+
+  // Returns the cache entry for {wire_bytes}, or null if there is no (valid)
+  // entry. Only does I/O, and can therefore be called from any thread.
+  std::unique_ptr<Entry> Lookup(const WasmFeatures& enabled,
+                                base::Vector<const uint8_t> wire_bytes) const;
+
+  // Returns a module object deserialized from {entry}, or an empty handle if
+  // it can't be deserialized in {isolate}.
+  static MaybeHandle<WasmModuleObject> Deserialize(
+      Isolate* isolate, const WasmFeatures& enabled, const Entry& entry,
+      base::Vector<const uint8_t> wire_bytes);
+
+  // Looks up and deserializes the cache entry for {wire_bytes}.
+  MaybeHandle<WasmModuleObject> Load(Isolate* isolate,
+                                     const WasmFeatures& enabled,
+                                     base::Vector<const uint8_t> wire_bytes);
+
+  // Keeps the cache entry of {native_module} up to date with its compiled code
+  // from now on.
+  void Track(const std::shared_ptr<NativeModule>& native_module);
+
+  // Serializes {native_module} and replaces the code of its cache entry with
+  // the result right away. Can be called from any thread.
+  void Store(NativeModule* native_module) const;
+
+  // Returns the path of the files of the entry for {wire_bytes}, without
+  // suffix.
+  std::string EntryPath(const WasmFeatures& enabled,
+                        base::Vector<const uint8_t> wire_bytes) const {
+    return EntryPath(directory_, enabled, wire_bytes);
+  }
+  static std::string EntryPath(const std::string& directory,
+                               const WasmFeatures& enabled,
+                               base::Vector<const uint8_t> wire_bytes);
+
+ private:
+  const std::string directory_;
+};
+
+}  // namespace wasm
+}  // namespace v8::internal
+
+#endif  // V8_WASM_WASM_DISK_CACHE_H_
@@ -27,6 +27,7 @@
 #include "src/wasm/stacks.h"
 #include "src/wasm/streaming-decoder.h"
 #include "src/wasm/wasm-debug.h"
+#include "src/wasm/wasm-disk-cache.h"
 #include "src/wasm/wasm-limits.h"
 #include "src/wasm/wasm-objects-inl.h"
 
@@ -439,7 +440,12 @@ struct WasmEngine::NativeModuleInfo {
   int8_t num_code_gcs_triggered = 0;
 };
 
-WasmEngine::WasmEngine() : call_descriptors_(&allocator_) {}
+WasmEngine::WasmEngine() : call_descriptors_(&allocator_) {
+  if (v8_flags.wasm_disk_cache_dir) {
+    disk_cache_ =
+        std::make_unique<WasmDiskCache>(v8_flags.wasm_disk_cache_dir.value());
+  }
+}
 
 WasmEngine::~WasmEngine() {
 #ifdef V8_ENABLE_WASM_GDB_REMOTE_DEBUGGING
@@ -539,6 +545,13 @@ MaybeHandle<WasmModuleObject> WasmEngine::SyncCompile(
     ModuleWireBytes bytes) {
   int compilation_id = next_compilation_id_.fetch_add(1);
   TRACE_EVENT1("v8.wasm", "wasm.SyncCompile", "id", compilation_id);
+  if (V8_UNLIKELY(disk_cache_)) {
+    Handle<WasmModuleObject> module_object;
+    if (disk_cache_->Load(isolate, enabled, bytes.module_bytes())
+            .ToHandle(&module_object)) {
+      return module_object;
+    }
+  }
   v8::metrics::Recorder::ContextId context_id =
       isolate->GetOrRegisterRecorderContextId(isolate->native_context());
   std::shared_ptr<WasmModule> module;
@@ -677,6 +690,7 @@ void WasmEngine::AsyncCompile(
     streaming_decoder->Finish();
     return;
   }
+
   // Make a copy of the wire bytes in case the user program changes them
   // during asynchronous compilation.
   base::OwnedVector<const uint8_t> copy =
@@ -1238,6 +1252,7 @@ std::shared_ptr<NativeModule> WasmEngine::NewNativeModule(
       static_cast<int>(isolate_info->native_modules.size()));
   isolate->counters()->wasm_modules_per_engine()->AddSample(
       static_cast<int>(native_modules_.size()));
+  if (V8_UNLIKELY(disk_cache_)) disk_cache_->Track(native_module);
   return native_module;
 }
 
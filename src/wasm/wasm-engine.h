@@ -22,6 +22,7 @@
 #include "src/tasks/operations-barrier.h"
 #include "src/wasm/canonical-types.h"
 #include "src/wasm/wasm-code-manager.h"
+#include "src/wasm/wasm-import-wrapper-cache.h"
 #include "src/wasm/wasm-tier.h"
 #include "src/zone/accounting-allocator.h"
 
@@ -48,6 +49,7 @@ class AsyncCompileJob;
 class ErrorThrower;
 struct ModuleWireBytes;
 class StreamingDecoder;
+class WasmDiskCache;
 class WasmFeatures;
 
 class V8_EXPORT_PRIVATE CompilationResultResolver {
@@ -224,6 +226,9 @@ class V8_EXPORT_PRIVATE WasmEngine {
 
   AccountingAllocator* allocator() { return &allocator_; }
 
+  // The on-disk cache of compiled modules, if enabled (--wasm-disk-cache-dir).
+  WasmDiskCache* disk_cache() const { return disk_cache_.get(); }
+
   // Compilation statistics for TurboFan compilations. Returns a shared_ptr
   // so that background compilation jobs can hold on to it while the main thread
   // shuts down.
@@ -365,6 +370,10 @@ class V8_EXPORT_PRIVATE WasmEngine {
 
   TypeCanonicalizer* type_canonicalizer() { return &type_canonicalizer_; }
 
+  SharedImportWrapperCache* shared_import_wrapper_cache() {
+    return &shared_import_wrapper_cache_;
+  }
+
   compiler::WasmCallDescriptors* call_descriptors() {
     return &call_descriptors_;
   }
@@ -403,6 +412,9 @@ class V8_EXPORT_PRIVATE WasmEngine {
 
   AccountingAllocator allocator_;
 
+  // On-disk cache of compiled modules (--wasm-disk-cache-dir).
+  std::unique_ptr<WasmDiskCache> disk_cache_;
+
 #ifdef V8_ENABLE_WASM_GDB_REMOTE_DEBUGGING
   // Implements a GDB-remote stub for WebAssembly debugging.
   std::unique_ptr<gdb_server::GdbServer> gdb_server_;
@@ -415,6 +427,8 @@ class V8_EXPORT_PRIVATE WasmEngine {
 
   TypeCanonicalizer type_canonicalizer_;
 
+  SharedImportWrapperCache shared_import_wrapper_cache_;
+
   compiler::WasmCallDescriptors call_descriptors_;
 
   // This mutex protects all information which is mutated concurrently or
@@ -6,6 +6,7 @@
 
 #include <vector>
 
+#include "src/flags/flags.h"
 #include "src/wasm/wasm-code-manager.h"
 
 namespace v8 {
@@ -57,6 +58,61 @@ WasmImportWrapperCache::~WasmImportWrapperCache() {
   WasmCode::DecrementRefCount(base::VectorOf(ptrs));
 }
 
+std::shared_ptr<const WasmCompilationResult> SharedImportWrapperCache::MaybeGet(
+    const CacheKey& key, const WasmFeatures& features) const {
+  base::MutexGuard lock(&mutex_);
+
+  auto it = entry_map_.find(key);
+  if (it == entry_map_.end() || !(it->second.features == features)) {
+    return nullptr;
+  }
+  return it->second.result;
+}
+
+std::shared_ptr<const WasmCompilationResult> SharedImportWrapperCache::Insert(
+    const CacheKey& key, const WasmFeatures& features,
+    WasmCompilationResult result) {
+  DCHECK(result.succeeded());
+  size_t code_size = result.code_desc.instr_size + result.code_desc.reloc_size;
+  auto shared_result =
+      std::make_shared<const WasmCompilationResult>(std::move(result));
+  base::MutexGuard lock(&mutex_);
+
+  auto it = entry_map_.find(key);
+  if (it != entry_map_.end()) {
+    if (it->second.features == features) return it->second.result;
+    // Wrappers compiled with different features are not interchangeable. Keep
+    // the most recent one; mixing features within a process is rare.
+    Remove(key);
+  }
+
+  // Evict the oldest wrappers to make room, but always keep the new one.
+  const size_t max_size = v8_flags.wasm_shared_import_wrappers_max_size;
+  while (!insertion_order_.empty() && code_size_ + code_size > max_size) {
+    Remove(insertion_order_.front());
+  }
+  insertion_order_.push_back(key);
+  entry_map_.emplace(key, Entry{features, shared_result, code_size,
+                                std::prev(insertion_order_.end())});
+  code_size_ += code_size;
+  return shared_result;
+}
+
+void SharedImportWrapperCache::Remove(const CacheKey& key) {
+  mutex_.AssertHeld();
+  auto it = entry_map_.find(key);
+  DCHECK(it != entry_map_.end());
+  DCHECK_GE(code_size_, it->second.code_size);
+  code_size_ -= it->second.code_size;
+  insertion_order_.erase(it->second.insertion_order_it);
+  entry_map_.erase(it);
+}
+
+size_t SharedImportWrapperCache::size() const {
+  base::MutexGuard lock(&mutex_);
+  return entry_map_.size();
+}
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
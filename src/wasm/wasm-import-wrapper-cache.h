@@ -9,8 +9,13 @@
 #ifndef V8_WASM_WASM_IMPORT_WRAPPER_CACHE_H_
 #define V8_WASM_WASM_IMPORT_WRAPPER_CACHE_H_
 
+#include <list>
+#include <memory>
+
 #include "src/base/platform/mutex.h"
 #include "src/compiler/wasm-compiler.h"
+#include "src/wasm/function-compiler.h"
+#include "src/wasm/wasm-features.h"
 
 namespace v8 {
 namespace internal {
@@ -88,6 +93,52 @@ class WasmImportWrapperCache {
   std::unordered_map<CacheKey, WasmCode*, CacheKeyHash> entry_map_;
 };
 
+// Process-wide cache of compiled import wrappers, owned by the {WasmEngine}.
+// Wrapper code calls runtime stubs through the jump tables of the
+// {NativeModule} it lives in, so the {WasmCode} objects themselves are still
+// per module. What is shared are the compilation results: their stub calls are
+// not resolved yet, so they can be copied into any {NativeModule} (of any
+// isolate) instead of compiling the same wrapper again. This saves compile
+// time, but not code space.
+// The cache holds at most --wasm-shared-import-wrappers-max-size bytes of
+// code; the least recently inserted wrappers are evicted first.
+class SharedImportWrapperCache {
+ public:
+  using CacheKey = WasmImportWrapperCache::CacheKey;
+
+  // Thread-safe. Returns nullptr if no wrapper for {key} was compiled with the
+  // same {features} yet, or if it was evicted.
+  V8_EXPORT_PRIVATE std::shared_ptr<const WasmCompilationResult> MaybeGet(
+      const CacheKey& key, const WasmFeatures& features) const;
+
+  // Thread-safe. Adds {result} to the cache and returns the cached result,
+  // which is the one of a concurrent {Insert} if that happened first.
+  V8_EXPORT_PRIVATE std::shared_ptr<const WasmCompilationResult> Insert(
+      const CacheKey& key, const WasmFeatures& features,
+      WasmCompilationResult result);
+
+  // Thread-safe. Returns the number of cached wrappers.
+  V8_EXPORT_PRIVATE size_t size() const;
+
+ private:
+  struct Entry {
+    WasmFeatures features;
+    std::shared_ptr<const WasmCompilationResult> result;
+    size_t code_size;
+    std::list<CacheKey>::iterator insertion_order_it;
+  };
+
+  // Removes the entry of {key}. Requires {mutex_} to be held.
+  void Remove(const CacheKey& key);
+
+  mutable base::Mutex mutex_;
+  std::unordered_map<CacheKey, Entry, WasmImportWrapperCache::CacheKeyHash>
+      entry_map_;
+  // The keys of {entry_map_}, least recently inserted first.
+  std::list<CacheKey> insertion_order_;
+  size_t code_size_ = 0;
+};
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
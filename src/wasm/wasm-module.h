@@ -14,6 +14,7 @@
 
 #include "src/base/optional.h"
 #include "src/base/platform/mutex.h"
+#include "src/base/platform/time.h"
 #include "src/base/vector.h"
 #include "src/codegen/signature.h"
 #include "src/common/globals.h"
@@ -482,6 +483,10 @@ struct FunctionTypeFeedback {
   // TODO(clemensb): This does not belong here; find a better place.
   int tierup_priority = 0;
 
+  // Time at which the function was first detected as hot, to measure tier-up
+  // latency. Reset once the function was compiled with TurboFan.
+  base::TimeTicks tierup_trigger_time;
+
   static constexpr uint32_t kNonDirectCall = 0xFFFFFFFF;
 };
 
@@ -4,6 +4,7 @@
 
 #include "src/wasm/wasm-serialization.h"
 
+#include "src/base/small-vector.h"
 #include "src/codegen/assembler-arch.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/debug/debug.h"
@@ -286,7 +287,7 @@ class V8_EXPORT_PRIVATE NativeModuleSerializer {
  private:
   size_t MeasureCode(const WasmCode*) const;
   void WriteHeader(Writer*, size_t total_code_size);
-  void WriteCode(const WasmCode*, Writer*);
+  void WriteCode(const WasmCode*, Writer*, Writer* code_writer);
   void WriteTieringBudget(Writer* writer);
 
   const NativeModule* const native_module_;
@@ -348,7 +349,8 @@ void NativeModuleSerializer::WriteHeader(Writer* writer,
 #endif
 }
 
-void NativeModuleSerializer::WriteCode(const WasmCode* code, Writer* writer) {
+void NativeModuleSerializer::WriteCode(const WasmCode* code, Writer* writer,
+                                       Writer* code_writer) {
   if (code == nullptr) {
     writer->Write(kLazyFunction);
     return;
@@ -390,11 +392,12 @@ void NativeModuleSerializer::WriteCode(const WasmCode* code, Writer* writer) {
   writer->Write(code->kind());
   writer->Write(code->tier());
 
-  // Get a pointer to the destination buffer, to hold relocated code.
-  byte* serialized_code_start = writer->current_buffer().begin();
+  // Get a pointer to the destination buffer in the code section, to hold
+  // relocated code.
+  byte* serialized_code_start = code_writer->current_buffer().begin();
   byte* code_start = serialized_code_start;
   size_t code_size = code->instructions().size();
-  writer->Skip(code_size);
+  code_writer->Skip(code_size);
   // Write the reloc info, source positions, and protected code.
   writer->WriteVector(code->reloc_info());
   writer->WriteVector(code->source_positions());
@@ -484,9 +487,15 @@ bool NativeModuleSerializer::Write(Writer* writer) {
   }
   WriteHeader(writer, total_code_size);
 
+  // The code of all functions is written in one contiguous section, in the
+  // order in which it will be allocated on deserialization. Like this, it can
+  // be copied into the code space in bulk.
+  Writer code_writer(writer->current_buffer().SubVector(0, total_code_size));
+  writer->Skip(total_code_size);
   for (WasmCode* code : code_table_) {
-    WriteCode(code, writer);
+    WriteCode(code, writer, &code_writer);
   }
+  DCHECK_EQ(0, code_writer.current_size());
   // If not a single function was written, serialization was not successful.
   if (num_turbofan_functions_ == 0) return false;
 
@@ -588,7 +597,8 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
   void ReadHeader(Reader* reader);
   DeserializationUnit ReadCode(int fn_index, Reader* reader);
   void ReadTieringBudget(Reader* reader);
-  void CopyAndRelocate(const DeserializationUnit& unit);
+  void CopyAndRelocate(base::Vector<const DeserializationUnit> batch);
+  void Relocate(const DeserializationUnit& unit);
   void Publish(std::vector<DeserializationUnit> batch);
 
   NativeModule* const native_module_;
@@ -599,6 +609,8 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
   // Updated in {ReadCode}.
   size_t remaining_code_size_ = 0;
   bool all_functions_validated_ = false;
+  // The not yet consumed part of the serialized code section.
+  base::Vector<const byte> code_section_;
   base::Vector<byte> current_code_space_;
   NativeModule::JumpTablesRef current_jump_tables_;
   std::vector<int> lazy_functions_;
@@ -620,9 +632,7 @@ class DeserializeCodeTask : public JobTask {
 
       auto batch = reloc_queue_->Pop();
       if (batch.empty()) break;
-      for (const auto& unit : batch) {
-        deserializer_->CopyAndRelocate(unit);
-      }
+      deserializer_->CopyAndRelocate(base::VectorOf(batch));
       publish_queue_.Add(std::move(batch));
       ResetPKUPermissionsForThreadSpawning pku_reset_scope;
       delegate->NotifyConcurrencyIncrease();
@@ -678,6 +688,8 @@ bool NativeModuleDeserializer::Read(Reader* reader) {
 #endif
 
   ReadHeader(reader);
+  if (remaining_code_size_ > reader->current_size()) return false;
+  code_section_ = reader->ReadVector<byte>(remaining_code_size_);
   uint32_t total_fns = native_module_->num_functions();
   uint32_t first_wasm_fn = native_module_->num_imported_functions();
 
@@ -721,6 +733,7 @@ bool NativeModuleDeserializer::Read(Reader* reader) {
   // We should have read the expected amount of code now, and should have fully
   // utilized the allocated code space.
   DCHECK_EQ(0, remaining_code_size_);
+  DCHECK_EQ(0, code_section_.size());
   DCHECK_EQ(0, current_code_space_.size());
 
   if (!batch.empty()) {
@@ -782,7 +795,8 @@ DeserializationUnit NativeModuleDeserializer::ReadCode(int fn_index,
   }
 
   DeserializationUnit unit;
-  unit.src_code_buffer = reader->ReadVector<byte>(code_size);
+  unit.src_code_buffer = code_section_.SubVector(0, code_size);
+  code_section_ += code_size;
   auto reloc_info = reader->ReadVector<byte>(reloc_size);
   auto source_pos = reader->ReadVector<byte>(source_position_size);
   auto protected_instructions =
@@ -803,11 +817,34 @@ DeserializationUnit NativeModuleDeserializer::ReadCode(int fn_index,
 }
 
 void NativeModuleDeserializer::CopyAndRelocate(
-    const DeserializationUnit& unit) {
-  memcpy(unit.code->instructions().begin(), unit.src_code_buffer.begin(),
-         unit.src_code_buffer.size());
+    base::Vector<const DeserializationUnit> batch) {
+  // Consecutive units are allocated back to back in the same code space (unless
+  // a new code space was started in between), and their code is also laid out
+  // back to back in the code section. Copy each such run with a single memcpy.
+  base::SmallVector<base::Vector<byte>, 4> runs;
+  for (size_t start = 0, end = 1; start < batch.size(); start = end++) {
+    while (end < batch.size() &&
+           batch[end].code->instructions().begin() ==
+               batch[end - 1].code->instructions().end() &&
+           batch[end].src_code_buffer.begin() ==
+               batch[end - 1].src_code_buffer.end()) {
+      ++end;
+    }
+    byte* dst = batch[start].code->instructions().begin();
+    size_t size = batch[end - 1].code->instructions().end() - dst;
+    memcpy(dst, batch[start].src_code_buffer.begin(), size);
+    runs.emplace_back(dst, size);
+  }
 
-  // Relocate the code.
+  for (const DeserializationUnit& unit : batch) Relocate(unit);
+
+  // Finally, flush the icache for the copied code.
+  for (base::Vector<byte> run : runs) {
+    FlushInstructionCache(run.begin(), run.size());
+  }
+}
+
+void NativeModuleDeserializer::Relocate(const DeserializationUnit& unit) {
   int mask = RelocInfo::ModeMask(RelocInfo::WASM_CALL) |
              RelocInfo::ModeMask(RelocInfo::WASM_STUB_CALL) |
              RelocInfo::ModeMask(RelocInfo::EXTERNAL_REFERENCE) |
@@ -851,10 +888,6 @@ void NativeModuleDeserializer::CopyAndRelocate(
         UNREACHABLE();
     }
   }
-
-  // Finally, flush the icache for that code.
-  FlushInstructionCache(unit.code->instructions().begin(),
-                        unit.code->instructions().size());
 }
 
 void NativeModuleDeserializer::ReadTieringBudget(Reader* reader) {
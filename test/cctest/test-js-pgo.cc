@@ -0,0 +1,164 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "include/v8-function.h"
+#include "src/api/api-inl.h"
+#include "src/base/platform/platform.h"
+#include "src/execution/isolate.h"
+#include "src/execution/pgo.h"
+#include "src/execution/tiering-manager.h"
+#include "src/objects/js-function-inl.h"
+#include "test/cctest/cctest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+const char kProfileFile[] = "test-js-pgo.profile";
+
+const char kSource[] =
+    "function f(o) { return o.x + o.y; }"
+    "function warmUp() { for (let i = 0; i < 3; i++) f({x: 1, y: i}); }"
+    "warmUp();";
+
+Handle<JSFunction> GetFunction(const char* name) {
+  return Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+      *v8::Local<v8::Function>::Cast(CompileRun(name))));
+}
+
+void SetPGOFlags() {
+  v8_flags.allow_natives_syntax = true;
+  v8_flags.lazy_feedback_allocation = false;
+  v8_flags.sparkplug = false;
+#ifdef V8_ENABLE_MAGLEV
+  v8_flags.maglev = false;
+#endif  // V8_ENABLE_MAGLEV
+  // Make sure that a single tick is not enough to tier up on its own.
+  v8_flags.max_bytecode_size_for_early_opt = 0;
+  v8_flags.ticks_before_optimization = 10;
+}
+
+#ifdef V8_ENABLE_TURBOFAN
+// Runs {kSource} in a new isolate and returns whether a single interrupt tick
+// of {f} marks it for Turbofan.
+bool TiersUpAfterOneTick() {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* v8_isolate = v8::Isolate::New(create_params);
+  bool result;
+  {
+    v8::Isolate::Scope isolate_scope(v8_isolate);
+    v8::HandleScope handle_scope(v8_isolate);
+    v8::Local<v8::Context> context = v8::Context::New(v8_isolate);
+    v8::Context::Scope context_scope(context);
+    Isolate* isolate = reinterpret_cast<Isolate*>(v8_isolate);
+
+    CompileRun(kSource);
+    Handle<JSFunction> f = GetFunction("f");
+    CHECK(f->has_feedback_vector());
+    isolate->tiering_manager()->OnInterruptTick(
+        f, CodeKind::INTERPRETED_FUNCTION, /* from_jump_loop */ false);
+    result = IsRequestTurbofan(f->tiering_state());
+  }
+  v8_isolate->Dispose();
+  return result;
+}
+#endif  // V8_ENABLE_TURBOFAN
+
+}  // namespace
+
+TEST(JSPGORoundTrip) {
+  SetPGOFlags();
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+
+  CompileRun(kSource);
+  Handle<JSFunction> f = GetFunction("f");
+  {
+    JSProfileInformation profile;
+    profile.RecordOptimization(*f, CodeKind::TURBOFAN);
+    profile.DumpToFile(kProfileFile);
+  }
+
+  std::unique_ptr<JSProfileInformation> loaded =
+      JSProfileInformation::LoadFromFile(kProfileFile);
+  CHECK(base::OS::Remove(kProfileFile));
+  CHECK(loaded);
+  CHECK(loaded->ProfiledTier(f->shared()) == CodeKind::TURBOFAN);
+  CHECK(loaded->HasProfiledTurbofanFeedback(*f));
+
+  // Polymorphic receivers are not what the function was profiled with.
+  CompileRun("f({y: 1, x: 2});");
+  CHECK(!loaded->HasProfiledTurbofanFeedback(*f));
+}
+
+TEST(JSPGORejectsMalformedData) {
+  SetPGOFlags();
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+
+  CompileRun(kSource);
+  JSProfileInformation profile;
+  profile.RecordOptimization(*GetFunction("f"), CodeKind::TURBOFAN);
+  profile.RecordOptimization(*GetFunction("warmUp"), CodeKind::MAGLEV);
+  std::vector<uint8_t> data = profile.Serialize();
+  CHECK(JSProfileInformation::Deserialize(base::VectorOf(data)));
+
+  // Truncated data.
+  for (size_t size = 0; size < data.size(); ++size) {
+    CHECK(!JSProfileInformation::Deserialize(
+        base::VectorOf(data.data(), size)));
+  }
+
+  // Trailing garbage.
+  std::vector<uint8_t> extended = data;
+  extended.push_back(0);
+  CHECK(!JSProfileInformation::Deserialize(base::VectorOf(extended)));
+
+  // Wrong magic number.
+  std::vector<uint8_t> corrupted = data;
+  corrupted[0] ^= 0xff;
+  CHECK(!JSProfileInformation::Deserialize(base::VectorOf(corrupted)));
+
+  // Invalid tier of the first function.
+  corrupted = data;
+  corrupted[3 * kUInt32Size + kInt64Size] = 0xff;
+  CHECK(!JSProfileInformation::Deserialize(base::VectorOf(corrupted)));
+
+  // A file with garbage in it does not crash either.
+  if (FILE* file = base::OS::FOpen(kProfileFile, "wb")) {
+    fwrite(corrupted.data(), 1, corrupted.size(), file);
+    base::Fclose(file);
+  }
+  CHECK(!JSProfileInformation::LoadFromFile(kProfileFile));
+  CHECK(base::OS::Remove(kProfileFile));
+  CHECK(!JSProfileInformation::LoadFromFile(kProfileFile));
+}
+
+#ifdef V8_ENABLE_TURBOFAN
+TEST(JSPGOProfiledFunctionTiersUpEarlier) {
+  SetPGOFlags();
+  v8_flags.js_pgo_file = kProfileFile;
+  CcTest::InitializeVM();
+  {
+    v8::HandleScope scope(CcTest::isolate());
+    CompileRun(kSource);
+    JSProfileInformation profile;
+    profile.RecordOptimization(*GetFunction("f"), CodeKind::TURBOFAN);
+    profile.DumpToFile(kProfileFile);
+  }
+
+  CHECK(!TiersUpAfterOneTick());
+
+  v8_flags.experimental_js_pgo_from_file = true;
+  bool tiers_up_with_profile = TiersUpAfterOneTick();
+  v8_flags.experimental_js_pgo_from_file = false;
+  CHECK(base::OS::Remove(kProfileFile));
+  CHECK(tiers_up_with_profile);
+}
+#endif  // V8_ENABLE_TURBOFAN
+
+}  // namespace internal
+}  // namespace v8
@@ -456,6 +456,32 @@ UNINITIALIZED_TEST(SnapshotCompression) {
   shared_space_blob.Dispose();
   context_blob.Dispose();
 }
+
+UNINITIALIZED_TEST(SnapshotCompressionChunked) {
+  DisableAlwaysOpt();
+  // Use small chunks, such that the startup blob is split into many of them.
+  v8_flags.snapshot_compression_chunk_size = 4 * KB;
+  base::Vector<const byte> startup_blob;
+  base::Vector<const byte> read_only_blob;
+  base::Vector<const byte> shared_space_blob;
+  base::Vector<const byte> context_blob;
+  SerializeContext(&startup_blob, &read_only_blob, &shared_space_blob,
+                   &context_blob);
+  SnapshotData original_snapshot_data(startup_blob);
+  SnapshotData compressed =
+      i::SnapshotCompression::Compress(&original_snapshot_data);
+  for (bool concurrent : {true, false}) {
+    v8_flags.concurrent_snapshot_decompression = concurrent;
+    SnapshotData decompressed =
+        i::SnapshotCompression::Decompress(compressed.RawData());
+    CHECK_EQ(startup_blob, decompressed.RawData());
+  }
+
+  startup_blob.Dispose();
+  read_only_blob.Dispose();
+  shared_space_blob.Dispose();
+  context_blob.Dispose();
+}
 #endif  // SNAPSHOT_COMPRESSION
 
 UNINITIALIZED_TEST(ContextSerializerContext) {
@@ -809,6 +835,50 @@ UNINITIALIZED_TEST(CustomSnapshotDataBlobStringNotInternalized) {
   FreeCurrentEmbeddedBlob();
 }
 
+UNINITIALIZED_TEST(CustomSnapshotDataBlobLazyStrings) {
+  DisableAlwaysOpt();
+  v8_flags.lazy_snapshot_strings = true;
+  v8_flags.lazy_snapshot_strings_min_length = 1024;
+  // The script source is long enough to be referenced in the snapshot blob.
+  const std::string function_source = "function f() { return 42; }";
+  const std::string source1 =
+      function_source + "\n// " + std::string(2 * KB, 'x') + "\n";
+
+  DisableEmbeddedBlobRefcounting();
+  v8::StartupData data1 = CreateSnapshotDataBlob(source1.c_str());
+
+  v8::Isolate::CreateParams params1;
+  params1.snapshot_blob = &data1;
+  params1.array_buffer_allocator = CcTest::array_buffer_allocator();
+
+  // Test-appropriate equivalent of v8::Isolate::New.
+  v8::Isolate* isolate1 = TestSerializer::NewIsolate(params1);
+  {
+    v8::Isolate::Scope i_scope(isolate1);
+    v8::HandleScope h_scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope c_scope(context);
+    v8::Maybe<int32_t> result = CompileRun("f()")->Int32Value(context);
+    CHECK_EQ(42, result.FromJust());
+    v8::String::Utf8Value f_source(isolate1, CompileRun("f.toString()"));
+    CHECK_EQ(function_source, *f_source);
+
+    i::Handle<i::JSFunction> f = i::Handle<i::JSFunction>::cast(
+        v8::Utils::OpenHandle(*CompileRun("f")));
+    i::String script_source =
+        i::String::cast(i::Script::cast(f->shared().script()).source());
+    CHECK_EQ(static_cast<int>(source1.length()), script_source.length());
+#ifndef V8_SNAPSHOT_COMPRESSION
+    // A compressed snapshot is decompressed into a temporary buffer, so the
+    // source has to be copied.
+    CHECK(script_source.IsExternalOneByteString());
+#endif  // V8_SNAPSHOT_COMPRESSION
+  }
+  isolate1->Dispose();
+  delete[] data1.data;  // We can dispose of the snapshot blob now.
+  FreeCurrentEmbeddedBlob();
+}
+
 namespace {
 
 void TestCustomSnapshotDataBlobWithIrregexpCode(
@@ -1614,6 +1684,76 @@ UNINITIALIZED_TEST(CustomSnapshotDataBlobImmortalImmovableRoots) {
   FreeCurrentEmbeddedBlob();
 }
 
+UNINITIALIZED_TEST(DefaultSnapshotCopyReadOnlyPages) {
+  // Copy the (padded) read-only pages of the default snapshot instead of
+  // mapping them from the binary.
+  v8_flags.map_read_only_snapshot_pages = false;
+
+  v8::Isolate::CreateParams params;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(params);
+  {
+    v8::Isolate::Scope i_scope(isolate);
+    v8::HandleScope h_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope c_scope(context);
+    CHECK_EQ(3,
+             CompileRun("[1, 2].length + 1")->Int32Value(context).FromJust());
+  }
+  isolate->Dispose();
+}
+
+// Only the read-only pages of a snapshot with static roots are dumped as is,
+// and only a snapshot that is embedded in the binary uncompressed can be mapped
+// from it.
+#if defined(V8_STATIC_ROOTS) && !defined(V8_USE_EXTERNAL_STARTUP_DATA) && \
+    !defined(V8_SNAPSHOT_COMPRESSION)
+namespace {
+int read_only_snapshot_bytes_mapped = 0;
+
+int* LookupReadOnlySnapshotCounter(const char* name) {
+  if (strcmp(name, "c:V8.ReadOnlySnapshotBytesMapped") == 0) {
+    return &read_only_snapshot_bytes_mapped;
+  }
+  return nullptr;
+}
+
+void CheckIsolateWorks(v8::Isolate* isolate) {
+  v8::Isolate::Scope i_scope(isolate);
+  v8::HandleScope h_scope(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope c_scope(context);
+  CHECK_EQ(3, CompileRun("[1, 2].length + 1")->Int32Value(context).FromJust());
+}
+}  // namespace
+
+UNINITIALIZED_TEST(DefaultSnapshotMapReadOnlyPages) {
+  if (!base::OS::IsRemapPageSupported()) return;
+  v8_flags.map_read_only_snapshot_pages = true;
+
+  v8::Isolate::CreateParams params;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  params.counter_lookup_callback = LookupReadOnlySnapshotCounter;
+  v8::Isolate* isolate1 = v8::Isolate::New(params);
+  CHECK_LT(0, read_only_snapshot_bytes_mapped);
+  CheckIsolateWorks(isolate1);
+
+  // Setting up a second Isolate verifies the checksum of the read-only
+  // snapshot against the one of the first (in debug builds).
+  v8::Isolate* isolate2 = v8::Isolate::New(params);
+  CheckIsolateWorks(isolate2);
+
+  // The pages are mapped privately, so writing to them (e.g. when rehashing)
+  // must not have changed the embedded blob.
+  CHECK(Snapshot::VerifyChecksum(
+      reinterpret_cast<Isolate*>(isolate1)->snapshot_blob()));
+
+  isolate2->Dispose();
+  isolate1->Dispose();
+}
+#endif  // defined(V8_STATIC_ROOTS) && !defined(V8_USE_EXTERNAL_STARTUP_DATA) &&
+        // !defined(V8_SNAPSHOT_COMPRESSION)
+
 TEST(TestThatAlwaysSucceeds) {}
 
 TEST(TestThatAlwaysFails) {
@@ -2708,6 +2848,109 @@ TEST(CodeSerializerAfterExecute) {
   v8_flags.always_turbofan = prev_always_turbofan_value;
 }
 
+#if ENABLE_SPARKPLUG
+static void CodeSerializerBaselineCode(bool merge_off_thread) {
+  if (!v8_flags.sparkplug) return;
+  // Merging requires the top-level code of the existing Script to be flushed.
+  if (merge_off_thread && !v8_flags.flush_bytecode) return;
+  bool prev_allow_natives_syntax = v8_flags.allow_natives_syntax;
+  bool prev_code_cache_baseline_code = v8_flags.code_cache_baseline_code;
+  bool prev_stress_background_compile = v8_flags.stress_background_compile;
+  v8_flags.allow_natives_syntax = true;
+  v8_flags.code_cache_baseline_code = true;
+  // --stress-background-compile makes the code cache go through the off-thread
+  // deserializer.
+  v8_flags.stress_background_compile = merge_off_thread;
+  FlagList::EnforceFlagImplications();
+
+  const char* js_source =
+      "function f() { return 'abc'; }; %CompileBaseline(f); f() + 'def'";
+  v8::ScriptCompiler::CachedData* cache =
+      CompileRunAndProduceCache(js_source, CodeCacheType::kAfterExecute);
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  Isolate* i_isolate2 = reinterpret_cast<Isolate*>(isolate2);
+
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(js_source);
+    v8::ScriptOrigin origin(isolate2, v8_str("test"));
+
+    // Leave a Script for the same source in the Isolate compilation cache,
+    // without its top-level code, so that the deserialized data is merged
+    // into it.
+    Handle<Script> cached_script;
+    if (merge_off_thread) {
+      i::HandleScope compilation_scope(i_isolate2);
+      v8::ScriptCompiler::Source no_cache_source(source_str, origin);
+      v8::Local<v8::UnboundScript> first_script =
+          v8::ScriptCompiler::CompileUnboundScript(isolate2, &no_cache_source)
+              .ToLocalChecked();
+      Handle<SharedFunctionInfo> toplevel = Handle<SharedFunctionInfo>::cast(
+          v8::Utils::OpenHandle(*first_script));
+      Handle<BytecodeArray> bytecode =
+          handle(toplevel->GetBytecodeArray(i_isolate2), i_isolate2);
+      for (int i = 0; i <= v8_flags.bytecode_old_age; ++i) {
+        bytecode->MakeOlder();
+      }
+      cached_script = compilation_scope.CloseAndEscape(
+          handle(Script::cast(toplevel->script()), i_isolate2));
+      CcTest::CollectAllGarbage(i_isolate2);
+      CcTest::CollectAllGarbage(i_isolate2);
+    }
+
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::Local<v8::UnboundScript> script;
+    {
+      DisallowCompilation no_compile_expected(i_isolate2);
+      script = v8::ScriptCompiler::CompileUnboundScript(
+                   isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+                   .ToLocalChecked();
+    }
+    CHECK(!cache->rejected);
+    if (merge_off_thread) {
+      CHECK_EQ(*cached_script,
+               Handle<SharedFunctionInfo>::cast(v8::Utils::OpenHandle(*script))
+                   ->script());
+    }
+
+    v8::Local<v8::Value> result =
+        script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK(result->ToString(context)
+              .ToLocalChecked()
+              ->Equals(context, v8_str("abcdef"))
+              .FromJust());
+
+    Handle<JSFunction> f = Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+        *context->Global()->Get(context, v8_str("f")).ToLocalChecked()));
+    // With short builtin calls, the pc-relative builtin calls of the baseline
+    // code have been re-resolved to the embedded blob of {isolate2}.
+    CHECK(f->shared().HasBaselineCode());
+  }
+  isolate2->Dispose();
+
+  // Restore the flags.
+  v8_flags.allow_natives_syntax = prev_allow_natives_syntax;
+  v8_flags.code_cache_baseline_code = prev_code_cache_baseline_code;
+  v8_flags.stress_background_compile = prev_stress_background_compile;
+  FlagList::EnforceFlagImplications();
+}
+
+TEST(CodeSerializerBaselineCode) {
+  CodeSerializerBaselineCode(/*merge_off_thread=*/false);
+}
+
+TEST(CodeSerializerBaselineCodeMergeOffThread) {
+  CodeSerializerBaselineCode(/*merge_off_thread=*/true);
+}
+#endif  // ENABLE_SPARKPLUG
+
 TEST(CodeSerializerFlagChange) {
   const char* js_source = "function f() { return 'abc'; }; f() + 'def'";
   v8::ScriptCompiler::CachedData* cache = CompileRunAndProduceCache(js_source);
@@ -2860,8 +3103,11 @@ TEST(Regress503552) {
   delete cache_data;
 }
 
-static void CodeSerializerMergeDeserializedScript(bool retain_toplevel_sfi) {
-  v8_flags.stress_background_compile = false;
+static void CodeSerializerMergeDeserializedScript(bool retain_toplevel_sfi,
+                                                  bool off_thread = false) {
+  // --stress-background-compile also makes the code cache go through the
+  // off-thread deserializer, which then starts the merge on its thread.
+  v8_flags.stress_background_compile = off_thread;
   CcTest::InitializeVM();
   Isolate* isolate = CcTest::i_isolate();
 
@@ -2920,6 +3166,48 @@ TEST(CodeSerializerMergeDeserializedScriptRetainingToplevelSfi) {
   CodeSerializerMergeDeserializedScript(/*retain_toplevel_sfi=*/true);
 }
 
+TEST(CodeSerializerMergeOffThreadDeserializedScript) {
+  CodeSerializerMergeDeserializedScript(/*retain_toplevel_sfi=*/false,
+                                        /*off_thread=*/true);
+}
+
+TEST(CodeSerializerMergeOffThreadDeserializedScriptRetainingToplevelSfi) {
+  CodeSerializerMergeDeserializedScript(/*retain_toplevel_sfi=*/true,
+                                        /*off_thread=*/true);
+}
+
+TEST(ProcessWideCompilationCache) {
+  v8_flags.process_wide_compilation_cache = true;
+  ProcessWideCompilationCache::Get()->Clear();
+
+  const char* js_source = "var greeting = 'hello'; greeting + ' world';";
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  for (int i = 0; i < 2; ++i) {
+    v8::Isolate* isolate = v8::Isolate::New(create_params);
+    {
+      v8::Isolate::Scope iscope(isolate);
+      v8::HandleScope scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+
+      v8::Local<v8::Value> result;
+      {
+        // Only the first Isolate has to compile the script.
+        base::Optional<DisallowCompilation> no_compile;
+        if (i > 0) no_compile.emplace(reinterpret_cast<Isolate*>(isolate));
+        result = CompileRun(js_source);
+      }
+      CHECK(result->Equals(context, v8_str("hello world")).FromJust());
+    }
+    isolate->Dispose();
+  }
+
+  ProcessWideCompilationCache::Get()->Clear();
+  v8_flags.process_wide_compilation_cache = false;
+}
+
 UNINITIALIZED_TEST(SnapshotCreatorBlobNotCreated) {
   DisableAlwaysOpt();
   DisableEmbeddedBlobRefcounting();
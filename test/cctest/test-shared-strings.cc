@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "include/v8-function.h"
 #include "include/v8-initialization.h"
 #include "src/api/api-inl.h"
 #include "src/api/api.h"
@@ -14,6 +15,7 @@
 #include "src/heap/memory-chunk-layout.h"
 #include "src/heap/memory-chunk.h"
 #include "src/heap/parked-scope.h"
+#include "src/heap/read-only-heap.h"
 #include "src/heap/remembered-set.h"
 #include "src/objects/fixed-array.h"
 #include "src/objects/heap-object.h"
@@ -2376,6 +2378,122 @@ UNINITIALIZED_TEST(SharedObjectRetainedByClientRememberedSet) {
   thread.Join();
 }
 
+#if V8_TARGET_ARCH_X64 || V8_TARGET_ARCH_IA32
+namespace {
+
+Handle<JSFunction> CompileAndGetFunction(v8::Isolate* isolate,
+                                         const char* source,
+                                         const char* name) {
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+  CompileRun(context, source).ToLocalChecked();
+  v8::Local<v8::Value> function = CompileRun(context, name).ToLocalChecked();
+  return Handle<JSFunction>::cast(v8::Utils::OpenHandle(*function));
+}
+
+Handle<SharedFunctionInfo> CompileAndGetSharedFunctionInfo(
+    v8::Isolate* isolate, const char* source, const char* name) {
+  return handle(CompileAndGetFunction(isolate, source, name)->shared(),
+                reinterpret_cast<Isolate*>(isolate));
+}
+
+int32_t CallWithSmi(v8::Isolate* isolate, Handle<JSFunction> function,
+                    int32_t arg) {
+  v8::Local<v8::Function> local = Utils::CallableToLocal(function);
+  v8::Local<v8::Context> context = local->GetCreationContextChecked();
+  v8::Context::Scope context_scope(context);
+  v8::Local<v8::Value> argv[] = {v8::Integer::New(isolate, arg)};
+  return local->Call(context, v8::Undefined(isolate), 1, argv)
+      .ToLocalChecked()
+      ->Int32Value(context)
+      .FromJust();
+}
+
+}  // namespace
+
+UNINITIALIZED_TEST(SharedBytecodeForIdenticalFunctions) {
+  if (!V8_CAN_CREATE_SHARED_HEAP_BOOL) return;
+  if (!ReadOnlyHeap::IsReadOnlySpaceShared()) return;
+
+  v8_flags.shared_string_table = true;
+  v8_flags.shared_bytecode = true;
+  v8_flags.enable_lazy_source_positions = false;
+  // Compile the scripts again for every context.
+  v8_flags.compilation_cache = false;
+
+  MultiClientIsolateTest test;
+  IsolateParkOnDisposeWrapper client_wrapper(test.NewClientIsolate(),
+                                             test.main_isolate());
+  v8::Isolate* isolate = test.main_isolate();
+  Isolate* i_isolate = test.i_main_isolate();
+  v8::Isolate* client = client_wrapper.isolate;
+  Isolate* i_client = reinterpret_cast<Isolate*>(client);
+  CHECK_NOT_NULL(i_isolate->shared_bytecode_table());
+  CHECK_EQ(i_isolate->shared_bytecode_table(),
+           i_client->shared_bytecode_table());
+
+  v8::HandleScope scope(isolate);
+  v8::HandleScope client_scope(client);
+
+  // Bytecode which only refers to Smis is shared.
+  const char* leaf_source = "function f(a) { return a * 2 + 1; } f(1);";
+  Handle<SharedFunctionInfo> leaf1 =
+      CompileAndGetSharedFunctionInfo(isolate, leaf_source, "f");
+  Handle<SharedFunctionInfo> leaf2 =
+      CompileAndGetSharedFunctionInfo(isolate, leaf_source, "f");
+  CHECK_NE(*leaf1, *leaf2);
+  CHECK(leaf1->HasBytecodeArray());
+  CHECK(leaf1->GetBytecodeArray(i_isolate).InSharedWritableHeap());
+  CHECK_EQ(leaf1->GetBytecodeArray(i_isolate),
+           leaf2->GetBytecodeArray(i_isolate));
+
+  // Bytecode referring to an isolate-local boilerplate description is not.
+  const char* literal_source = "function g() { return {x: 1}; } g();";
+  Handle<SharedFunctionInfo> literal1 =
+      CompileAndGetSharedFunctionInfo(isolate, literal_source, "g");
+  Handle<SharedFunctionInfo> literal2 =
+      CompileAndGetSharedFunctionInfo(isolate, literal_source, "g");
+  CHECK(literal1->HasBytecodeArray());
+  CHECK(!literal1->GetBytecodeArray(i_isolate).InSharedWritableHeap());
+  CHECK_NE(literal1->GetBytecodeArray(i_isolate),
+           literal2->GetBytecodeArray(i_isolate));
+
+  // The same function compiled by a client isolate references the same
+  // bytecode. Both isolates run on this thread, so the one that isn't used is
+  // parked to not block safepoints of the other.
+  Handle<JSFunction> main_leaf =
+      CompileAndGetFunction(isolate, leaf_source, "f");
+  Handle<JSFunction> client_leaf;
+  {
+    ParkedScope parked(i_isolate->main_thread_local_isolate());
+    v8::Isolate::Scope isolate_scope(client);
+    client_leaf = CompileAndGetFunction(client, leaf_source, "f");
+    CHECK_NE(client_leaf->shared(), *leaf1);
+    CHECK_EQ(client_leaf->shared().GetBytecodeArray(i_client),
+             leaf1->GetBytecodeArray(i_isolate));
+  }
+
+  // Shared bytecode survives GCs of the shared heap, and both isolates can
+  // still run it afterwards.
+  {
+    ParkedScope parked(i_client->main_thread_local_isolate());
+    CcTest::CollectSharedGarbage(i_isolate);
+  }
+  CHECK_EQ(leaf1->GetBytecodeArray(i_isolate),
+           leaf2->GetBytecodeArray(i_isolate));
+  CHECK_EQ(client_leaf->shared().GetBytecodeArray(i_client),
+           leaf1->GetBytecodeArray(i_isolate));
+  // Marking doesn't age shared bytecode.
+  CHECK_EQ(0, leaf1->GetBytecodeArray(i_isolate).bytecode_age());
+  CHECK_EQ(7, CallWithSmi(isolate, main_leaf, 3));
+  {
+    ParkedScope parked(i_isolate->main_thread_local_isolate());
+    v8::Isolate::Scope isolate_scope(client);
+    CHECK_EQ(7, CallWithSmi(client, client_leaf, 3));
+  }
+}
+#endif  // V8_TARGET_ARCH_X64 || V8_TARGET_ARCH_IA32
+
 }  // namespace test_shared_strings
 }  // namespace internal
 }  // namespace v8
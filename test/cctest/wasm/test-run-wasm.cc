@@ -7,6 +7,8 @@
 #include <string.h>
 
 #include "src/base/overflowing-math.h"
+#include "src/codegen/assembler-inl.h"
+#include "src/codegen/external-reference.h"
 #include "src/utils/utils.h"
 #include "src/wasm/code-space-access.h"
 #include "src/wasm/wasm-opcodes-inl.h"
@@ -1635,6 +1637,57 @@ WASM_EXEC_TEST(LoadMem_offset_oob) {
   }
 }
 
+namespace {
+// Returns the number of out-of-line traps in the Turbofan code of the main
+// function of {r}. Without runtime exception support, each of them calls the
+// trap callback for testing.
+template <typename ReturnType, typename... ParamTypes>
+int CountTraps(WasmRunner<ReturnType, ParamTypes...>& r) {
+  WasmCodeRefScope code_ref_scope;
+  WasmCode* code = r.builder().GetFunctionCode(r.function_index());
+  CHECK_EQ(ExecutionTier::kTurbofan, code->tier());
+  Address trap_callback =
+      ExternalReference::wasm_call_trap_callback_for_testing().address();
+  int traps = 0;
+  for (RelocIterator it(code->instructions(), code->reloc_info(),
+                        code->constant_pool(),
+                        RelocInfo::ModeMask(RelocInfo::EXTERNAL_REFERENCE));
+       !it.done(); it.next()) {
+    if (it.rinfo()->target_external_reference() == trap_callback) ++traps;
+  }
+  return traps;
+}
+}  // namespace
+
+TEST(DominatedBoundsChecksAreEliminated) {
+  // Use explicit bounds checks instead of the trap handler.
+  FLAG_SCOPE(wasm_enforce_bounds_checks);
+  constexpr uint32_t kBoundary = kWasmPageSize - 12;
+  // The bounds check of the access at offset 8 implies the one of the access
+  // at offset 0, so the latter is eliminated.
+  {
+    WasmRunner<int32_t, uint32_t> r(TestExecutionTier::kTurbofan);
+    r.builder().AddMemoryElems<byte>(kWasmPageSize);
+    r.Build({WASM_LOAD_MEM_OFFSET(MachineType::Int32(), 8, WASM_LOCAL_GET(0)),
+             WASM_LOAD_MEM(MachineType::Int32(), WASM_LOCAL_GET(0)),
+             kExprI32Add});
+    CHECK_EQ(1, CountTraps(r));
+    CHECK_EQ(0, r.Call(kBoundary));
+    CHECK_TRAP(r.Call(kBoundary + 1));
+  }
+  // The other way round, both bounds checks are needed.
+  {
+    WasmRunner<int32_t, uint32_t> r(TestExecutionTier::kTurbofan);
+    r.builder().AddMemoryElems<byte>(kWasmPageSize);
+    r.Build({WASM_LOAD_MEM(MachineType::Int32(), WASM_LOCAL_GET(0)),
+             WASM_LOAD_MEM_OFFSET(MachineType::Int32(), 8, WASM_LOCAL_GET(0)),
+             kExprI32Add});
+    CHECK_EQ(2, CountTraps(r));
+    CHECK_EQ(0, r.Call(kBoundary));
+    CHECK_TRAP(r.Call(kBoundary + 1));
+  }
+}
+
 WASM_EXEC_TEST(LoadMemI32_offset) {
   WasmRunner<int32_t, int32_t> r(execution_tier);
   int32_t* memory =
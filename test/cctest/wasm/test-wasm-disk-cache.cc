@@ -0,0 +1,298 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdio>
+#include <vector>
+
+#include "src/base/platform/platform.h"
+#include "src/base/platform/wrappers.h"
+#include "src/wasm/wasm-code-manager.h"
+#include "src/wasm/wasm-disk-cache.h"
+#include "src/wasm/wasm-engine.h"
+#include "src/wasm/wasm-module-builder.h"
+#include "src/wasm/wasm-objects-inl.h"
+#include "test/cctest/cctest.h"
+#include "test/common/flag-utils.h"
+#include "test/common/wasm/test-signatures.h"
+#include "test/common/wasm/wasm-macro-gen.h"
+#include "test/common/wasm/wasm-module-runner.h"
+
+namespace v8::internal::wasm {
+
+namespace {
+
+constexpr int kNumFunctions = 3;
+
+std::vector<uint8_t> ReadFile(const std::string& path) {
+  std::vector<uint8_t> contents;
+  FILE* file = base::OS::FOpen(path.c_str(), "rb");
+  if (!file) return contents;
+  int c;
+  while ((c = fgetc(file)) != EOF) contents.push_back(static_cast<uint8_t>(c));
+  base::Fclose(file);
+  return contents;
+}
+
+void WriteFile(const std::string& path, const std::vector<uint8_t>& contents) {
+  FILE* file = base::OS::FOpen(path.c_str(), "wb");
+  CHECK_NOT_NULL(file);
+  CHECK_EQ(contents.size(), fwrite(contents.data(), 1, contents.size(), file));
+  base::Fclose(file);
+}
+
+// Approximate gtest TEST_F style, in case we adopt gtest.
+class WasmDiskCacheTest {
+ public:
+  WasmDiskCacheTest() : zone_(&allocator_, ZONE_NAME), cache_(".") {
+    CcTest::InitIsolateOnce();
+    // Generate functions "f0", "f1", ..., each returning its argument plus 1.
+    WasmModuleBuilder* builder = zone_.New<WasmModuleBuilder>(&zone_);
+    TestSignatures sigs;
+    for (int i = 0; i < kNumFunctions; ++i) {
+      WasmFunctionBuilder* f = builder->AddFunction(sigs.i_i());
+      byte code[] = {WASM_LOCAL_GET(0), kExprI32Const, 1, kExprI32Add,
+                     kExprEnd};
+      f->EmitCode(code, sizeof(code));
+      builder->AddExport(base::CStrVector(FunctionName(i).c_str()), f);
+    }
+    ZoneBuffer buffer(&zone_);
+    builder->WriteTo(&buffer);
+    wire_bytes_.assign(buffer.begin(), buffer.end());
+    path_ = cache_.EntryPath(WasmFeatures::FromIsolate(CcTest::i_isolate()),
+                             base::VectorOf(wire_bytes_));
+  }
+
+  ~WasmDiskCacheTest() {
+    base::OS::Remove(wire_bytes_path().c_str());
+    base::OS::Remove(code_path().c_str());
+  }
+
+  WasmDiskCache* cache() { return &cache_; }
+  base::Vector<const uint8_t> wire_bytes() const {
+    return base::VectorOf(wire_bytes_);
+  }
+  std::string wire_bytes_path() const {
+    return path_ + WasmDiskCache::kWireBytesSuffix;
+  }
+  std::string code_path() const { return path_ + WasmDiskCache::kCodeSuffix; }
+
+  static std::string FunctionName(int index) {
+    return "f" + std::to_string(index);
+  }
+
+  // Compiles and instantiates the module in a new isolate, and runs {callback}
+  // with the instance. Afterwards, the module is gone (also from the engine's
+  // module cache), so that loading it from the disk cache must deserialize
+  // it.
+  template <typename Callback>
+  void RunInNewIsolate(Callback callback) {
+    v8::Isolate::CreateParams create_params;
+    create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+    v8::Isolate* v8_isolate = v8::Isolate::New(create_params);
+    Isolate* isolate = reinterpret_cast<Isolate*>(v8_isolate);
+    std::weak_ptr<NativeModule> weak_native_module;
+    {
+      v8::Isolate::Scope isolate_scope(v8_isolate);
+      v8::HandleScope scope(v8_isolate);
+      LocalContext env(v8_isolate);
+      testing::SetupIsolateForWasmModule(isolate);
+      ErrorThrower thrower(isolate, "WasmDiskCacheTest");
+      Handle<WasmModuleObject> module_object =
+          GetWasmEngine()
+              ->SyncCompile(isolate, WasmFeatures::FromIsolate(isolate),
+                            &thrower, ModuleWireBytes(wire_bytes()))
+              .ToHandleChecked();
+      weak_native_module = module_object->shared_native_module();
+      Handle<WasmInstanceObject> instance =
+          GetWasmEngine()
+              ->SyncInstantiate(isolate, &thrower, module_object, {}, {})
+              .ToHandleChecked();
+      callback(isolate, instance, module_object->native_module());
+    }
+    v8_isolate->Dispose();
+    // Busy-wait for the NativeModule to really die. Background threads might
+    // temporarily keep it alive.
+    while (weak_native_module.lock()) {
+    }
+  }
+
+  // Runs function {index} until it was tiered up to Turbofan.
+  static void TierUp(Isolate* isolate, Handle<WasmInstanceObject> instance,
+                     int index) {
+    NativeModule* native_module = instance->module_object().native_module();
+    Handle<Object> params[1] = {handle(Smi::FromInt(41), isolate)};
+    while (!IsTurbofan(native_module, index)) {
+      CHECK_EQ(42, testing::CallWasmFunctionForTesting(
+                       isolate, instance, FunctionName(index).c_str(), 1,
+                       params));
+    }
+  }
+
+  static bool IsTurbofan(NativeModule* native_module, int index) {
+    WasmCodeRefScope code_ref_scope;
+    WasmCode* code = native_module->GetCode(index);
+    return code != nullptr && code->tier() == ExecutionTier::kTurbofan;
+  }
+
+  // Compiles the module in a new isolate, tiers up "f0", and stores the
+  // module in the cache.
+  void StoreEntry() {
+    RunInNewIsolate([this](Isolate* isolate,
+                           Handle<WasmInstanceObject> instance,
+                           NativeModule* native_module) {
+      TierUp(isolate, instance, 0);
+      cache()->Store(native_module);
+    });
+    CHECK(!ReadFile(wire_bytes_path()).empty());
+    CHECK(!ReadFile(code_path()).empty());
+  }
+
+  MaybeHandle<WasmModuleObject> Load() {
+    Isolate* isolate = CcTest::i_isolate();
+    return cache_.Load(isolate, WasmFeatures::FromIsolate(isolate),
+                       wire_bytes());
+  }
+
+ private:
+  AccountingAllocator allocator_;
+  Zone zone_;
+  WasmDiskCache cache_;
+  std::vector<uint8_t> wire_bytes_;
+  std::string path_;
+};
+
+}  // namespace
+
+TEST(WasmDiskCacheRoundTrip) {
+  WasmDiskCacheTest test;
+  test.StoreEntry();
+
+  Isolate* isolate = CcTest::i_isolate();
+  HandleScope scope(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(CcTest::isolate());
+  v8::Context::Scope context_scope(context);
+  Handle<WasmModuleObject> module_object;
+  CHECK(test.Load().ToHandle(&module_object));
+  NativeModule* native_module = module_object->native_module();
+  CHECK_EQ(test.wire_bytes(), native_module->wire_bytes());
+  // The tiered-up code was stored.
+  CHECK(WasmDiskCacheTest::IsTurbofan(native_module, 0));
+
+  ErrorThrower thrower(isolate, "WasmDiskCacheRoundTrip");
+  Handle<WasmInstanceObject> instance =
+      GetWasmEngine()
+          ->SyncInstantiate(isolate, &thrower, module_object, {}, {})
+          .ToHandleChecked();
+  Handle<Object> params[1] = {handle(Smi::FromInt(41), isolate)};
+  CHECK_EQ(42, testing::CallWasmFunctionForTesting(isolate, instance, "f0", 1,
+                                                   params));
+}
+
+TEST(WasmDiskCacheRejectsInvalidEntries) {
+  WasmDiskCacheTest test;
+  test.StoreEntry();
+  const std::vector<uint8_t> wire_bytes_file =
+      ReadFile(test.wire_bytes_path());
+  const std::vector<uint8_t> code_file = ReadFile(test.code_path());
+
+  HandleScope scope(CcTest::i_isolate());
+  v8::Local<v8::Context> context = v8::Context::New(CcTest::isolate());
+  v8::Context::Scope context_scope(context);
+  WasmFeatures enabled = WasmFeatures::FromIsolate(CcTest::i_isolate());
+  CHECK_NOT_NULL(test.cache()->Lookup(enabled, test.wire_bytes()));
+
+  // Other wire bytes with the same hash.
+  std::vector<uint8_t> corrupted = wire_bytes_file;
+  corrupted.back() ^= 1;
+  WriteFile(test.wire_bytes_path(), corrupted);
+  CHECK_NULL(test.cache()->Lookup(enabled, test.wire_bytes()));
+
+  // Wire bytes of a different size.
+  corrupted = wire_bytes_file;
+  corrupted.pop_back();
+  WriteFile(test.wire_bytes_path(), corrupted);
+  CHECK_NULL(test.cache()->Lookup(enabled, test.wire_bytes()));
+
+  // Code that was stored for another generation of the wire bytes file.
+  WriteFile(test.wire_bytes_path(), wire_bytes_file);
+  corrupted = code_file;
+  corrupted[2 * kUInt32Size] ^= 1;
+  WriteFile(test.code_path(), corrupted);
+  CHECK_NULL(test.cache()->Lookup(enabled, test.wire_bytes()));
+
+  // Code without any serialized module.
+  corrupted.resize(4 * kUInt32Size);
+  WriteFile(test.code_path(), code_file);
+  CHECK_NOT_NULL(test.cache()->Lookup(enabled, test.wire_bytes()));
+  WriteFile(test.code_path(), corrupted);
+  CHECK_NULL(test.cache()->Lookup(enabled, test.wire_bytes()));
+
+  // A truncated serialized module fails to deserialize.
+  corrupted = code_file;
+  corrupted.resize(corrupted.size() / 2);
+  WriteFile(test.code_path(), corrupted);
+  CHECK_NOT_NULL(test.cache()->Lookup(enabled, test.wire_bytes()));
+  CHECK(test.Load().is_null());
+
+  // Missing files.
+  base::OS::Remove(test.code_path().c_str());
+  CHECK_NULL(test.cache()->Lookup(enabled, test.wire_bytes()));
+  WriteFile(test.code_path(), code_file);
+  base::OS::Remove(test.wire_bytes_path().c_str());
+  CHECK_NULL(test.cache()->Lookup(enabled, test.wire_bytes()));
+
+  // Features that differ from the isolate's.
+  WriteFile(test.wire_bytes_path(), wire_bytes_file);
+  CHECK(!test.Load().is_null());
+  if (WasmFeatures::All() != enabled) {
+    CHECK(test.cache()
+              ->Load(CcTest::i_isolate(), WasmFeatures::All(),
+                     test.wire_bytes())
+              .is_null());
+  }
+}
+
+TEST(WasmDiskCacheUpdatesEntryOnTierUp) {
+  // Only dynamic tiering produces tier-up chunks after compilation.
+  if (!v8_flags.liftoff || !v8_flags.wasm_dynamic_tiering) return;
+  FlagScope<int> no_write_delay(&v8_flags.wasm_disk_cache_write_delay, 0);
+  WasmDiskCacheTest test;
+
+  std::vector<uint8_t> wire_bytes_file;
+  test.RunInNewIsolate([&test, &wire_bytes_file](
+                           Isolate* isolate,
+                           Handle<WasmInstanceObject> instance,
+                           NativeModule* native_module) {
+    test.cache()->Track(instance->module_object().shared_native_module());
+
+    // Tiering up "f0" creates the entry.
+    WasmDiskCacheTest::TierUp(isolate, instance, 0);
+    while (ReadFile(test.code_path()).empty()) {
+      base::OS::Sleep(base::TimeDelta::FromMilliseconds(1));
+    }
+    wire_bytes_file = ReadFile(test.wire_bytes_path());
+    CHECK(!wire_bytes_file.empty());
+
+    // Tiering up "f1" adds its code to the entry. Only the code is written
+    // again, the wire bytes keep their generation.
+    size_t code_size = ReadFile(test.code_path()).size();
+    WasmDiskCacheTest::TierUp(isolate, instance, 1);
+    while (ReadFile(test.code_path()).size() <= code_size) {
+      base::OS::Sleep(base::TimeDelta::FromMilliseconds(1));
+    }
+    CHECK_EQ(wire_bytes_file, ReadFile(test.wire_bytes_path()));
+  });
+
+  HandleScope scope(CcTest::i_isolate());
+  v8::Local<v8::Context> context = v8::Context::New(CcTest::isolate());
+  v8::Context::Scope context_scope(context);
+  Handle<WasmModuleObject> module_object;
+  CHECK(test.Load().ToHandle(&module_object));
+  NativeModule* native_module = module_object->native_module();
+  CHECK(WasmDiskCacheTest::IsTurbofan(native_module, 0));
+  CHECK(WasmDiskCacheTest::IsTurbofan(native_module, 1));
+  CHECK(!WasmDiskCacheTest::IsTurbofan(native_module, 2));
+}
+
+}  // namespace v8::internal::wasm
@@ -11,6 +11,7 @@
 #include "src/wasm/wasm-module.h"
 #include "src/wasm/wasm-objects.h"
 #include "test/cctest/cctest.h"
+#include "test/common/flag-utils.h"
 #include "test/common/wasm/test-signatures.h"
 
 namespace v8 {
@@ -163,6 +164,96 @@ TEST(CacheHitMissSig) {
   CHECK_EQ(c2, c4);
 }
 
+TEST(SharedAcrossModules) {
+  if (!v8_flags.wasm_shared_import_wrappers) return;
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  auto module1 = NewModule(isolate);
+  auto module2 = NewModule(isolate);
+  TestSignatures sigs;
+  WasmCodeRefScope wasm_code_ref_scope;
+
+  auto kind = compiler::WasmImportCallKind::kJSFunctionArityMatch;
+  auto sig = sigs.i_ll();
+  int expected_arity = static_cast<int>(sig->parameter_count());
+  uint32_t canonical_type_index =
+      GetTypeCanonicalizer()->AddRecursiveGroup(sig);
+  SharedImportWrapperCache::CacheKey key(kind, canonical_type_index,
+                                         expected_arity, kNoSuspend);
+  SharedImportWrapperCache* shared_cache =
+      GetWasmEngine()->shared_import_wrapper_cache();
+
+  WasmCode* c1;
+  {
+    WasmImportWrapperCache::ModificationScope cache_scope(
+        module1->import_wrapper_cache());
+    c1 = CompileImportWrapper(module1.get(), isolate->counters(), kind, sig,
+                              canonical_type_index, expected_arity, kNoSuspend,
+                              &cache_scope);
+  }
+  std::shared_ptr<const WasmCompilationResult> result =
+      shared_cache->MaybeGet(key, WasmFeatures::All());
+  CHECK_NOT_NULL(result);
+
+  // The second module reuses the compilation result, but gets its own copy of
+  // the code.
+  WasmCode* c2;
+  {
+    WasmImportWrapperCache::ModificationScope cache_scope(
+        module2->import_wrapper_cache());
+    c2 = CompileImportWrapper(module2.get(), isolate->counters(), kind, sig,
+                              canonical_type_index, expected_arity, kNoSuspend,
+                              &cache_scope);
+  }
+  CHECK_NE(c1, c2);
+  CHECK_EQ(module1.get(), c1->native_module());
+  CHECK_EQ(module2.get(), c2->native_module());
+  CHECK_EQ(WasmCode::Kind::kWasmToJsWrapper, c2->kind());
+  CHECK_EQ(c1->instructions().size(), c2->instructions().size());
+  CHECK_EQ(result, shared_cache->MaybeGet(key, WasmFeatures::All()));
+}
+
+TEST(SharedCacheIsBounded) {
+  if (!v8_flags.wasm_shared_import_wrappers) return;
+  // Every wrapper exceeds the limit, so only the most recent one is kept.
+  FlagScope<size_t> max_size(&v8_flags.wasm_shared_import_wrappers_max_size,
+                             1);
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  auto module = NewModule(isolate);
+  TestSignatures sigs;
+  WasmCodeRefScope wasm_code_ref_scope;
+  WasmImportWrapperCache::ModificationScope cache_scope(
+      module->import_wrapper_cache());
+  SharedImportWrapperCache* shared_cache =
+      GetWasmEngine()->shared_import_wrapper_cache();
+
+  auto kind = compiler::WasmImportCallKind::kJSFunctionArityMatch;
+  auto sig1 = sigs.i_i();
+  int expected_arity1 = static_cast<int>(sig1->parameter_count());
+  uint32_t canonical_type_index1 =
+      GetTypeCanonicalizer()->AddRecursiveGroup(sig1);
+  SharedImportWrapperCache::CacheKey key1(kind, canonical_type_index1,
+                                          expected_arity1, kNoSuspend);
+  auto sig2 = sigs.i_ii();
+  int expected_arity2 = static_cast<int>(sig2->parameter_count());
+  uint32_t canonical_type_index2 =
+      GetTypeCanonicalizer()->AddRecursiveGroup(sig2);
+  SharedImportWrapperCache::CacheKey key2(kind, canonical_type_index2,
+                                          expected_arity2, kNoSuspend);
+
+  CompileImportWrapper(module.get(), isolate->counters(), kind, sig1,
+                       canonical_type_index1, expected_arity1, kNoSuspend,
+                       &cache_scope);
+  CHECK_NOT_NULL(shared_cache->MaybeGet(key1, WasmFeatures::All()));
+  CHECK_EQ(1, shared_cache->size());
+
+  CompileImportWrapper(module.get(), isolate->counters(), kind, sig2,
+                       canonical_type_index2, expected_arity2, kNoSuspend,
+                       &cache_scope);
+  CHECK_NULL(shared_cache->MaybeGet(key1, WasmFeatures::All()));
+  CHECK_NOT_NULL(shared_cache->MaybeGet(key2, WasmFeatures::All()));
+  CHECK_EQ(1, shared_cache->size());
+}
+
 }  // namespace test_wasm_import_wrapper_cache
 }  // namespace wasm
 }  // namespace internal
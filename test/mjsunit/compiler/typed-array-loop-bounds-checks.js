@@ -0,0 +1,62 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Bounds checks dominated by the loop condition.
+(function() {
+  function fill(a, v) {
+    for (let i = 0; i < a.length; ++i) a[i] = v + i;
+    return a;
+  }
+
+  %PrepareFunctionForOptimization(fill);
+  assertEquals([1, 2, 3], Array.from(fill(new Int32Array(3), 1)));
+  %OptimizeFunctionOnNextCall(fill);
+  assertEquals([1, 2, 3, 4], Array.from(fill(new Int32Array(4), 1)));
+  assertEquals([], Array.from(fill(new Int32Array(0), 1)));
+  assertOptimized(fill);
+})();
+
+(function() {
+  function sum(a) {
+    let s = 0;
+    for (let i = 0; !(a.length <= i); ++i) s += a[i];
+    return s;
+  }
+
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(6, sum(new Float64Array([1, 2, 3])));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(10, sum(new Float64Array([1, 2, 3, 4])));
+  assertOptimized(sum);
+})();
+
+// Accesses that aren't dominated by the loop condition must still be checked.
+(function() {
+  function shifted(a) {
+    let s = 0;
+    for (let i = 0; i < a.length; ++i) s += a[i + 1];
+    return s;
+  }
+
+  %PrepareFunctionForOptimization(shifted);
+  assertEquals(NaN, shifted(new Float64Array([1, 2, 3])));
+  %OptimizeFunctionOnNextCall(shifted);
+  assertEquals(NaN, shifted(new Float64Array([1, 2, 3])));
+})();
+
+(function() {
+  function other_length(a, b) {
+    let s = 0;
+    for (let i = 0; i < a.length; ++i) s += b[i];
+    return s;
+  }
+
+  %PrepareFunctionForOptimization(other_length);
+  assertEquals(3, other_length(new Int8Array(3), new Int8Array([1, 1, 1])));
+  %OptimizeFunctionOnNextCall(other_length);
+  assertEquals(3, other_length(new Int8Array(3), new Int8Array([1, 1, 1])));
+  assertEquals(NaN, other_length(new Int8Array(3), new Int8Array([1, 1])));
+})();
@@ -0,0 +1,35 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Flags: --allow-natives-syntax --maglev --turbofan --osr-past-maglev
+// Flags: --no-stress-opt --no-lazy-feedback-allocation --no-sparkplug
+// Flags: --interrupt-budget=1 --interrupt-budget-for-maglev=1
+// Flags: --ticks-before-optimization=100000 --max-bytecode-size-for-early-opt=0
+
+// An interpreted frame of f that ticks on return after f's Maglev code became
+// available is not stuck in a loop, and must not send f to Turbofan.
+function f(callback) {
+  callback();
+  return 1;
+}
+
+function g() {
+  assertTrue(%IsTurbofanEnabled());
+  // The outer call of f runs in the interpreter, the inner calls tier f up to
+  // Maglev.
+  f(() => {
+    for (let i = 0; i < 100000 && !isMaglevved(f); i++) {
+      f(() => {});
+    }
+    assertTrue(isMaglevved(f));
+  });
+  assertFalse(isTurboFanned(f));
+  const status = %GetOptimizationStatus(f);
+  assertEquals(0, status & V8OptimizationStatus.kMarkedForOptimization);
+  assertEquals(
+      0, status & V8OptimizationStatus.kMarkedForConcurrentOptimization);
+}
+%NeverOptimizeFunction(g);
+
+g();
@@ -0,0 +1,27 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Flags: --allow-natives-syntax --maglev --turbofan --osr-past-maglev
+// Flags: --use-osr --no-stress-opt --no-baseline-batch-compilation
+// Flags: --ticks-before-optimization=100000
+
+// With this many ticks required, f only reaches Turbofan (within the
+// iteration limit) by OSR'ing past Maglev while stuck in its loop.
+let keep_going = 10000000;  // A counter to avoid test hangs on failure.
+
+function f() {
+  let reached_tf = false;
+  while (!reached_tf && --keep_going) {
+    reached_tf = %CurrentFrameIsTurbofan();
+  }
+}
+
+function g() {
+  assertTrue(%IsTurbofanEnabled());
+  f();
+  assertTrue(keep_going > 0);
+}
+%NeverOptimizeFunction(g);
+
+g();
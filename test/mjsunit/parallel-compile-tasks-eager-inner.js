@@ -0,0 +1,60 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --lazy-compile-dispatcher --parallel-compile-tasks-for-eager-inner --use-external-strings
+
+// A bundle: module functions wrapped in an IIFE, which are eagerly compiled
+// because they are parenthesized.
+var result = (function(modules) {
+  var cache = {};
+  function require(id) {
+    if (!(id in cache)) {
+      var module = {exports: {}};
+      modules[id](module, require);
+      cache[id] = module.exports;
+    }
+    return cache[id];
+  }
+  return require('main');
+})({
+  'main': (function(module, require) {
+    var util = require('util');
+    module.exports = util.add(40, 2);
+  }),
+  'util': (function(module, require) {
+    var count = 0;
+    module.exports = {
+      add: (function(a, b) {
+        count++;
+        return a + b;
+      }),
+    };
+  }),
+});
+
+assertEquals(42, result);
+
+// Eager inner functions referring to variables of their outer functions.
+(function() {
+  var outer = 1;
+  var inner = (function() {
+    let block = 2;
+    return (function() { return outer + block; })();
+  })();
+  assertEquals(3, inner);
+  assertEquals(4, (function(a) { return a + outer; })(3));
+})();
+
+// Eager inner generators and functions with default parameters.
+(function() {
+  var gen = (function*() {
+    yield 1;
+    yield 2;
+  })();
+  assertEquals(1, gen.next().value);
+  assertEquals(2, gen.next().value);
+
+  var x = 41;
+  assertEquals(42, (function(a = x + 1) { return a; })());
+})();
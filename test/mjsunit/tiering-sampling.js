@@ -0,0 +1,24 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --turbofan --tiering-sampling --tiering-sampling-interval=100
+// Flags: --allow-natives-syntax --nomaglev --no-always-turbofan
+
+function f(n) {
+  let s = 0;
+  for (let i = 0; i < n; i++) {
+    s += i;
+  }
+  return s;
+}
+
+// Samples are taken asynchronously, so we can't rely on {f} being optimized
+// after any fixed amount of work; we keep running it until it is (or the test
+// times out).
+while (!isOptimized(f)) {
+  assertEquals(4950, f(100));
+  %FinalizeOptimization();
+}
+assertOptimized(f);
+assertEquals(4950, f(100));
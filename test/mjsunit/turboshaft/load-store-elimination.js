@@ -0,0 +1,108 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Flags: --turboshaft --allow-natives-syntax
+
+// Redundant loads of the same field.
+function load_load(o) {
+  return o.x + o.x;
+}
+
+%PrepareFunctionForOptimization(load_load);
+assertEquals(4, load_load({x: 2}));
+%OptimizeFunctionOnNextCall(load_load);
+assertEquals(4, load_load({x: 2}));
+assertEquals(6, load_load({x: 3}));
+
+// A load following a store to the same field.
+function store_load(o, v) {
+  o.x = v;
+  return o.x;
+}
+
+%PrepareFunctionForOptimization(store_load);
+assertEquals(1, store_load({x: 0}, 1));
+%OptimizeFunctionOnNextCall(store_load);
+assertEquals(1, store_load({x: 0}, 1));
+assertEquals(5, store_load({x: 0}, 5));
+
+// Two objects with the same shape can be the same object.
+function may_alias(a, b) {
+  a.x = 1;
+  b.x = 2;
+  return a.x;
+}
+
+%PrepareFunctionForOptimization(may_alias);
+let o = {x: 0};
+assertEquals(1, may_alias({x: 0}, {x: 0}));
+assertEquals(2, may_alias(o, o));
+%OptimizeFunctionOnNextCall(may_alias);
+assertEquals(1, may_alias({x: 0}, {x: 0}));
+assertEquals(2, may_alias(o, o));
+
+// Stores that are overwritten before being observed.
+function store_store(o, v) {
+  o.x = v;
+  o.x = v + 1;
+  return o;
+}
+
+%PrepareFunctionForOptimization(store_store);
+assertEquals(2, store_store({x: 0}, 1).x);
+%OptimizeFunctionOnNextCall(store_store);
+assertEquals(2, store_store({x: 0}, 1).x);
+
+// A store that is observed by a call in between must be kept.
+let observed;
+function observe(o) {
+  observed = o.x;
+}
+%NeverOptimizeFunction(observe);
+
+function store_call_store(o, v) {
+  o.x = v;
+  observe(o);
+  o.x = v + 1;
+  return o;
+}
+
+%PrepareFunctionForOptimization(store_call_store);
+assertEquals(2, store_call_store({x: 0}, 1).x);
+assertEquals(1, observed);
+%OptimizeFunctionOnNextCall(store_call_store);
+assertEquals(8, store_call_store({x: 0}, 7).x);
+assertEquals(7, observed);
+
+// Fields are only known on a merge if they are known on all paths.
+function merge(o, c) {
+  if (c) {
+    o.x = 1;
+  } else {
+    o.x = 2;
+  }
+  return o.x;
+}
+
+%PrepareFunctionForOptimization(merge);
+assertEquals(1, merge({x: 0}, true));
+assertEquals(2, merge({x: 0}, false));
+%OptimizeFunctionOnNextCall(merge);
+assertEquals(1, merge({x: 0}, true));
+assertEquals(2, merge({x: 0}, false));
+
+// Loop bodies can change fields that were known before the loop.
+function loop(o, n) {
+  o.x = 0;
+  for (let i = 0; i < n; ++i) {
+    o.x = o.x + 1;
+  }
+  return o.x;
+}
+
+%PrepareFunctionForOptimization(loop);
+assertEquals(3, loop({x: 0}, 3));
+%OptimizeFunctionOnNextCall(loop);
+assertEquals(3, loop({x: 0}, 3));
+assertEquals(10, loop({x: 0}, 10));
@@ -89,3 +89,18 @@ assertPromiseResult(async function invalidSectionCode() {
   // Async and streaming decoder disagree on the error message, so accept both.
   await assertCompileError(buffer, /(unknown|invalid) section code/);
 }());
+
+assertPromiseResult(async function firstOfManyBadFunctions() {
+  // Functions are validated concurrently with decoding the data section. The
+  // reported error should still be the one of the first invalid function.
+  let builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1);
+  let sig = builder.addType(kSig_i_v);
+  builder.addFunction('a', sig).addBody([kExprI32Const, 42]);
+  for (var i = 0; i < 100; ++i) {
+    builder.addFunction('bad' + i, sig).addBody([]);
+  }
+  builder.addDataSegment(0, [1, 2, 3]);
+  let buffer = builder.toBuffer();
+  await assertCompileError(buffer, /Compiling function #1:"bad0" failed/);
+}());
@@ -408,6 +408,113 @@ d8.file.execute("test/mjsunit/wasm/wasm-module-builder.js");
   assertEquals(42, instance.exports.main(42));
 })();
 
+(function EscapeAnalysisWithLoadsAcrossCalls() {
+  print(arguments.callee.name);
+
+  let builder = new WasmModuleBuilder();
+  let struct = builder.addStruct([makeField(kWasmI32, true),
+                                  makeField(kWasmI8, true),
+                                  makeField(kWasmI16, true),
+                                  makeField(kWasmF64, false)]);
+
+  let nop = builder.addFunction("nop", kSig_v_v).addBody([]);
+
+  // The calls prevent load elimination from forwarding the stored values, so
+  // only escape analysis can replace the loads. The packed fields are stored
+  // with upper bits that their loads have to sign- or zero-extend away.
+  builder.addFunction("main", makeSig([kWasmI32, kWasmF64], [kWasmF64]))
+    .addLocals(wasmRefNullType(struct), 1)
+    .addBody([
+      kExprLocalGet, 0,
+      kExprLocalGet, 0,
+      kExprLocalGet, 0,
+      kExprLocalGet, 1,
+      kGCPrefix, kExprStructNew, struct,
+      kExprLocalSet, 2,
+      kExprCallFunction, nop.index,
+      kExprLocalGet, 2,
+      kExprLocalGet, 0, kExprI32Const, 1, kExprI32Add,
+      kGCPrefix, kExprStructSet, struct, 0,
+      kExprCallFunction, nop.index,
+      kExprLocalGet, 2,
+      kGCPrefix, kExprStructGet, struct, 0,
+      kExprLocalGet, 2,
+      kGCPrefix, kExprStructGetS, struct, 1,
+      kExprI32Add,
+      kExprLocalGet, 2,
+      kGCPrefix, kExprStructGetU, struct, 2,
+      kExprI32Add,
+      kExprF64SConvertI32,
+      kExprLocalGet, 2,
+      kGCPrefix, kExprStructGet, struct, 3,
+      kExprF64Add])
+    .exportFunc();
+
+  let instance = builder.instantiate({});
+  assertEquals(43 + 42 + 42 + 0.5, instance.exports.main(42, 0.5));
+  // 0x1ff is stored as 0xff to the i8 and as 0x1ff to the i16 field.
+  assertEquals(0x200 - 1 + 0x1ff + 0.5, instance.exports.main(0x1ff, 0.5));
+  // -1 is stored as 0xff to the i8 and as 0xffff to the i16 field.
+  assertEquals(0 - 1 + 0xffff + 0.5, instance.exports.main(-1, 0.5));
+  // 0x18000 is stored as 0x00 to the i8 and as 0x8000 to the i16 field.
+  assertEquals(0x18001 + 0 + 0x8000 + 0.5,
+               instance.exports.main(0x18000, 0.5));
+})();
+
+(function EscapeAnalysisWithArrayStoresAtUnknownIndices() {
+  print(arguments.callee.name);
+
+  let builder = new WasmModuleBuilder();
+  let array = builder.addArray(kWasmI32, true);
+
+  let nop = builder.addFunction("nop", kSig_v_v).addBody([]);
+
+  // A store with a computed index might overwrite the initial value of any
+  // element, so escape analysis must not forward values across it.
+  builder.addFunction("setAtIndexGetFirst", kSig_i_ii)
+    .addLocals(wasmRefNullType(array), 1)
+    .addBody([
+      kExprI32Const, 10,
+      kExprI32Const, 20,
+      kGCPrefix, kExprArrayNewFixed, array, 2,
+      kExprLocalSet, 2,
+      kExprCallFunction, nop.index,
+      kExprLocalGet, 2,
+      kExprLocalGet, 0,
+      kExprLocalGet, 1,
+      kGCPrefix, kExprArraySet, array,
+      kExprCallFunction, nop.index,
+      kExprLocalGet, 2,
+      kExprI32Const, 0,
+      kGCPrefix, kExprArrayGet, array])
+    .exportFunc();
+
+  // Likewise, a load with a computed index might read any element.
+  builder.addFunction("setFirstGetAtIndex", kSig_i_ii)
+    .addLocals(wasmRefNullType(array), 1)
+    .addBody([
+      kExprI32Const, 10,
+      kExprI32Const, 20,
+      kGCPrefix, kExprArrayNewFixed, array, 2,
+      kExprLocalSet, 2,
+      kExprCallFunction, nop.index,
+      kExprLocalGet, 2,
+      kExprI32Const, 0,
+      kExprLocalGet, 1,
+      kGCPrefix, kExprArraySet, array,
+      kExprCallFunction, nop.index,
+      kExprLocalGet, 2,
+      kExprLocalGet, 0,
+      kGCPrefix, kExprArrayGet, array])
+    .exportFunc();
+
+  let instance = builder.instantiate({});
+  assertEquals(42, instance.exports.setAtIndexGetFirst(0, 42));
+  assertEquals(10, instance.exports.setAtIndexGetFirst(1, 42));
+  assertEquals(42, instance.exports.setFirstGetAtIndex(0, 42));
+  assertEquals(20, instance.exports.setFirstGetAtIndex(1, 42));
+})();
+
 (function AllocationFolding() {
   print(arguments.callee.name);
   var builder = new WasmModuleBuilder();
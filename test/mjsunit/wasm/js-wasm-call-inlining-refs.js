@@ -0,0 +1,86 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbofan --no-always-turbofan
+// Flags: --turbo-inline-js-wasm-calls --experimental-wasm-gc
+
+// JS-to-Wasm calls with reference parameters and results are inlined into
+// optimized JS code.
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+const builder = new WasmModuleBuilder();
+const struct = builder.addStruct([makeField(kWasmI32, true)]);
+const deopt = builder.addImport('m', 'deopt', kSig_v_v);
+
+builder.addFunction('identity', kSig_r_r)
+    .addBody([kExprLocalGet, 0])
+    .exportFunc();
+builder.addFunction('make', makeSig([kWasmI32], [wasmRefType(struct)]))
+    .addBody([kExprLocalGet, 0, kGCPrefix, kExprStructNew, struct])
+    .exportFunc();
+builder.addFunction('get', makeSig([wasmRefNullType(struct)], [kWasmI32]))
+    .addBody([kExprLocalGet, 0, kGCPrefix, kExprStructGet, struct, 0])
+    .exportFunc();
+builder.addFunction('callDeopt', kSig_r_r)
+    .addBody([kExprCallFunction, deopt, kExprLocalGet, 0])
+    .exportFunc();
+
+let deoptTarget = null;
+const instance = builder.instantiate({m: {deopt: () => {
+  if (deoptTarget) %DeoptimizeFunction(deoptTarget);
+}}});
+const exports = instance.exports;
+
+(function testExternRef() {
+  print(arguments.callee.name);
+  function f(x) {
+    return exports.identity(x);
+  }
+  const o = {};
+  %PrepareFunctionForOptimization(f);
+  assertSame(o, f(o));
+  %OptimizeFunctionOnNextCall(f);
+  assertSame(o, f(o));
+  assertEquals(1, f(1));
+  assertSame(null, f(null));
+  assertOptimized(f);
+})();
+
+(function testTypedReferences() {
+  print(arguments.callee.name);
+  function f(x) {
+    return exports.get(exports.make(x));
+  }
+  function g(s) {
+    return exports.get(s);
+  }
+  %PrepareFunctionForOptimization(f);
+  %PrepareFunctionForOptimization(g);
+  assertEquals(1, f(1));
+  assertEquals(2, g(exports.make(2)));
+  %OptimizeFunctionOnNextCall(f);
+  %OptimizeFunctionOnNextCall(g);
+  assertEquals(3, f(3));
+  assertEquals(4, g(exports.make(4)));
+  // The parameter type is still checked.
+  assertThrows(() => g({}), TypeError);
+  assertTraps(kTrapNullDereference, () => g(null));
+})();
+
+(function testLazyDeoptWithReferenceResult() {
+  print(arguments.callee.name);
+  function f(x) {
+    return exports.callDeopt(x);
+  }
+  const o = {};
+  %PrepareFunctionForOptimization(f);
+  assertSame(o, f(o));
+  %OptimizeFunctionOnNextCall(f);
+  assertSame(o, f(o));
+  assertOptimized(f);
+  deoptTarget = f;
+  assertSame(o, f(o));
+  assertUnoptimized(f);
+})();
@@ -0,0 +1,84 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --liftoff --no-wasm-tier-up
+// Flags: --no-wasm-lazy-compilation
+
+// Liftoff keeps locals in registers across loop headers. Check that back edges
+// correctly move the updated values back into these registers.
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+(function testLoopLocalsInRegisters() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  const imp = builder.addImport('m', 'f', kSig_i_i);
+  // Sum of 1..n.
+  builder.addFunction('sum', kSig_i_i)
+      .addLocals(kWasmI32, 1)
+      .addBody([
+        kExprLoop, kWasmVoid,
+          kExprLocalGet, 1, kExprLocalGet, 0, kExprI32Add, kExprLocalSet, 1,
+          kExprLocalGet, 0, kExprI32Const, 1, kExprI32Sub, kExprLocalTee, 0,
+          kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 1
+      ])
+      .exportFunc();
+  // Two locals sharing the same register when entering the loop; computes
+  // n * 2^n.
+  builder.addFunction('shared', kSig_i_i)
+      .addLocals(kWasmI32, 2)
+      .addBody([
+        kExprLocalGet, 0, kExprLocalSet, 1,
+        kExprLocalGet, 0, kExprLocalSet, 2,
+        kExprLoop, kWasmVoid,
+          kExprLocalGet, 1, kExprI32Const, 1, kExprI32Shl, kExprLocalSet, 1,
+          kExprLocalGet, 2, kExprI32Const, 1, kExprI32Sub, kExprLocalTee, 2,
+          kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 1
+      ])
+      .exportFunc();
+  // A call in the loop body spills all registers; the back edge has to reload
+  // the locals.
+  builder.addFunction('call', kSig_i_i)
+      .addLocals(kWasmI32, 1)
+      .addBody([
+        kExprLoop, kWasmVoid,
+          kExprLocalGet, 1, kExprLocalGet, 0, kExprCallFunction, imp,
+          kExprI32Add, kExprLocalSet, 1,
+          kExprLocalGet, 0, kExprI32Const, 1, kExprI32Sub, kExprLocalTee, 0,
+          kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 1
+      ])
+      .exportFunc();
+  // Floating point locals, leaving the loop with a forward branch.
+  builder.addFunction('f64', makeSig([kWasmF64, kWasmI32], [kWasmF64]))
+      .addLocals(kWasmF64, 1)
+      .addBody([
+        kExprBlock, kWasmVoid,
+          kExprLoop, kWasmVoid,
+            kExprLocalGet, 1, kExprI32Eqz, kExprBrIf, 1,
+            kExprLocalGet, 2, kExprLocalGet, 0, kExprF64Add, kExprLocalSet, 2,
+            kExprLocalGet, 1, kExprI32Const, 1, kExprI32Sub, kExprLocalSet, 1,
+            kExprBr, 0,
+          kExprEnd,
+        kExprEnd,
+        kExprLocalGet, 2
+      ])
+      .exportFunc();
+
+  const instance = builder.instantiate({m: {f: x => 2 * x}});
+  for (const name of ['sum', 'shared', 'call', 'f64']) {
+    assertTrue(%IsLiftoffFunction(instance.exports[name]));
+  }
+  assertEquals(55, instance.exports.sum(10));
+  assertEquals(5050, instance.exports.sum(100));
+  assertEquals(5 * 32, instance.exports.shared(5));
+  assertEquals(110, instance.exports.call(10));
+  assertEquals(7.5, instance.exports.f64(1.5, 5));
+  assertEquals(0, instance.exports.f64(1.5, 0));
+})();
@@ -0,0 +1,145 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --experimental-wasm-revectorize --no-liftoff
+// Flags: --no-wasm-lazy-compilation
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+// Each function below computes two simd128 results from adjacent memory and
+// stores them to adjacent memory, which makes them candidates for packing
+// into simd256 operations. Additions, subtractions and multiplications are
+// packed; the simd256 counterparts of the other operations are not supported
+// by the backend, so the revectorizer has to leave them alone. Either way, the
+// functions have to compute the same results as without revectorization.
+
+const kA = 0;
+const kB = 32;
+const kMask = 64;
+const kResult = 96;
+
+function load(address) {
+  return [...wasmI32Const(address), kSimdPrefix, kExprS128LoadMem, 0, 0];
+}
+
+function store(address, value) {
+  return [...wasmI32Const(address), ...value,
+          kSimdPrefix, kExprS128StoreMem, 0, 0];
+}
+
+function binop(opcode) {
+  let body = [];
+  for (let i = 0; i < 32; i += 16) {
+    body.push(...store(kResult + i, [...load(kA + i), ...load(kB + i),
+                                     ...SimdInstr(opcode)]));
+  }
+  return body;
+}
+
+function select() {
+  let body = [];
+  for (let i = 0; i < 32; i += 16) {
+    body.push(...store(kResult + i, [...load(kA + i), ...load(kB + i),
+                                     ...load(kMask + i),
+                                     kSimdPrefix, kExprS128Select]));
+  }
+  return body;
+}
+
+function extendLoad(opcode) {
+  let body = [];
+  for (let i = 0; i < 2; ++i) {
+    body.push(...store(kResult + 16 * i,
+                       [...wasmI32Const(kA + 8 * i),
+                        kSimdPrefix, opcode, 0, 0]));
+  }
+  return body;
+}
+
+const builder = new WasmModuleBuilder();
+builder.addMemory(1, 1);
+builder.exportMemoryAs('memory');
+const kBinops = {
+  add: kExprF32x4Add,
+  sub: kExprF32x4Sub,
+  mul: kExprF32x4Mul,
+  div: kExprF32x4Div,
+  pmin: kExprF32x4Pmin,
+  pmax: kExprF32x4Pmax,
+  eq: kExprF32x4Eq,
+  ne: kExprF32x4Ne,
+  lt: kExprF32x4Lt,
+  le: kExprF32x4Le,
+};
+for (let [name, opcode] of Object.entries(kBinops)) {
+  builder.addFunction(name, kSig_v_v).addBody(binop(opcode)).exportFunc();
+}
+builder.addFunction('select', kSig_v_v).addBody(select()).exportFunc();
+builder.addFunction('load8x8s', kSig_v_v)
+    .addBody(extendLoad(kExprS128Load8x8S)).exportFunc();
+builder.addFunction('load16x4u', kSig_v_v)
+    .addBody(extendLoad(kExprS128Load16x4U)).exportFunc();
+builder.addFunction('load32x2s', kSig_v_v)
+    .addBody(extendLoad(kExprS128Load32x2S)).exportFunc();
+const instance = builder.instantiate();
+const exports = instance.exports;
+const buffer = exports.memory.buffer;
+
+const a = [1.5, -2, 3, 100, 0.25, -8, 7, 16];
+const b = [3, 4, -3, 1, 0.25, 2, -7, 16];
+new Float32Array(buffer, kA, 8).set(a);
+new Float32Array(buffer, kB, 8).set(b);
+new Int32Array(buffer, kMask, 8).set([-1, 0, 0xffff, -1, 0, -1, 0x0f0f0f0f, 0]);
+
+(function TestF32x4Binops() {
+  print(arguments.callee.name);
+  let result_f32 = new Float32Array(buffer, kResult, 8);
+  let result_i32 = new Int32Array(buffer, kResult, 8);
+  function check(name, expected, result) {
+    exports[name]();
+    for (let i = 0; i < 8; ++i) {
+      assertEquals(expected(a[i], b[i]), result[i], `${name} lane ${i}`);
+    }
+  }
+  check('add', (x, y) => Math.fround(x + y), result_f32);
+  check('sub', (x, y) => Math.fround(x - y), result_f32);
+  check('mul', (x, y) => Math.fround(x * y), result_f32);
+  check('div', (x, y) => Math.fround(x / y), result_f32);
+  check('pmin', (x, y) => y < x ? y : x, result_f32);
+  check('pmax', (x, y) => x < y ? y : x, result_f32);
+  check('eq', (x, y) => x == y ? -1 : 0, result_i32);
+  check('ne', (x, y) => x != y ? -1 : 0, result_i32);
+  check('lt', (x, y) => x < y ? -1 : 0, result_i32);
+  check('le', (x, y) => x <= y ? -1 : 0, result_i32);
+})();
+
+(function TestS128Select() {
+  print(arguments.callee.name);
+  let a_i32 = new Int32Array(buffer, kA, 8);
+  let b_i32 = new Int32Array(buffer, kB, 8);
+  let mask = new Int32Array(buffer, kMask, 8);
+  let result = new Int32Array(buffer, kResult, 8);
+  exports.select();
+  for (let i = 0; i < 8; ++i) {
+    assertEquals((a_i32[i] & mask[i]) | (b_i32[i] & ~mask[i]), result[i]);
+  }
+})();
+
+(function TestExtendingLoads() {
+  print(arguments.callee.name);
+  let bytes = new Int8Array(buffer, kA, 16);
+  for (let i = 0; i < 16; ++i) bytes[i] = i * 37 - 128;
+
+  exports.load8x8s();
+  assertEquals(Array.from(new Int8Array(buffer, kA, 16)),
+               Array.from(new Int16Array(buffer, kResult, 16)));
+
+  exports.load16x4u();
+  assertEquals(Array.from(new Uint16Array(buffer, kA, 8)),
+               Array.from(new Int32Array(buffer, kResult, 8)));
+
+  exports.load32x2s();
+  assertEquals(Array.from(new Int32Array(buffer, kA, 4), x => BigInt(x)),
+               Array.from(new BigInt64Array(buffer, kResult, 4)));
+})();
@@ -722,6 +722,80 @@ TEST_F(MergeDeserializedCodeTest, MergeWithNoFollowUpWork) {
            GetSharedFunctionInfo(original_script));
 }
 
+TEST_F(MergeDeserializedCodeTest, NoMainThreadMergeWithoutBackgroundMerge) {
+  i::v8_flags.merge_background_deserialized_script_with_compilation_cache =
+      true;
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data;
+  IsolateAndContextScope scope(this);
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate());
+  i::DisableConservativeStackScanningScopeForTesting no_stack_scanning(
+      i_isolate->heap());
+
+  ScriptOrigin default_origin(isolate(), NewString(""));
+
+  constexpr char kSourceCode[] = "function f() {}";
+  Local<Script> original_script;
+
+  // Compile the script for the first time, to both populate the Isolate
+  // compilation cache and produce code cache data.
+  {
+    v8::EscapableHandleScope handle_scope(isolate());
+    Local<Script> script =
+        Script::Compile(context(), NewString(kSourceCode), &default_origin)
+            .ToLocalChecked();
+
+    cached_data.reset(
+        ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+
+    // Retain the v8::Script (a JSFunction) so that the original Script stays
+    // alive.
+    original_script = handle_scope.Escape(script);
+  }
+
+  // Age the top-level bytecode so that the Isolate compilation cache will
+  // contain only the Script.
+  i::BytecodeArray bytecode =
+      GetSharedFunctionInfo(original_script).GetBytecodeArray(i_isolate);
+  const int kAgingThreshold = 6;
+  for (int j = 0; j < kAgingThreshold; ++j) {
+    bytecode.MakeOlder();
+  }
+  i_isolate->heap()->CollectAllGarbage(i::Heap::kNoGCFlags,
+                                       i::GarbageCollectionReason::kTesting);
+
+  // A second round of GC is necessary in case incremental marking had already
+  // started before the bytecode was aged.
+  i_isolate->heap()->CollectAllGarbage(i::Heap::kNoGCFlags,
+                                       i::GarbageCollectionReason::kTesting);
+
+  DeserializeThread deserialize_thread(ScriptCompiler::StartConsumingCodeCache(
+      isolate(), std::make_unique<ScriptCompiler::CachedData>(
+                     cached_data->data, cached_data->length,
+                     ScriptCompiler::CachedData::BufferNotOwned)));
+  CHECK(deserialize_thread.Start());
+  deserialize_thread.Join();
+
+  std::unique_ptr<ScriptCompiler::ConsumeCodeCacheTask> task =
+      deserialize_thread.TakeTask();
+
+  task->SourceTextAvailable(isolate(), NewString(kSourceCode), default_origin);
+  CHECK(task->ShouldMergeWithExistingScript());
+
+  // Don't call MergeWithExistingScript. Completing the compilation must not
+  // do the background part of the merge on the main thread, so the newly
+  // deserialized Script is used instead of the original one.
+  ScriptCompiler::Source source(NewString(kSourceCode), default_origin,
+                                cached_data.release(), task.release());
+  Local<Script> script =
+      ScriptCompiler::Compile(context(), &source,
+                              ScriptCompiler::kConsumeCodeCache)
+          .ToLocalChecked();
+
+  CHECK(!source.GetCachedData()->rejected);
+  CHECK_NE(GetSharedFunctionInfo(script).script(),
+           GetSharedFunctionInfo(original_script).script());
+}
+
 TEST_F(MergeDeserializedCodeTest, MergeThatCompilesLazyFunction) {
   i::v8_flags.merge_background_deserialized_script_with_compilation_cache =
       true;
@@ -2,11 +2,15 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <vector>
+
 #include "include/v8-context.h"
 #include "include/v8-isolate.h"
 #include "include/v8-local-handle.h"
 #include "include/v8-primitive.h"
 #include "include/v8-template.h"
+#include "src/api/api-inl.h"
 #include "src/objects/objects-inl.h"
 #include "test/unittests/test-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -228,5 +232,55 @@ TEST_F(ScriptTest, ProduceCompileHints) {
   }
 }
 
+namespace {
+
+struct CompileHintsData {
+  std::vector<int> hints;
+  std::vector<int> queried_positions;
+};
+
+bool CompileHintCallback(int position, void* data) {
+  CompileHintsData* compile_hints = reinterpret_cast<CompileHintsData*>(data);
+  compile_hints->queried_positions.push_back(position);
+  return std::find(compile_hints->hints.begin(), compile_hints->hints.end(),
+                   position) != compile_hints->hints.end();
+}
+
+bool IsFunctionCompiled(Local<Context> context, const char* name) {
+  Local<Value> value =
+      context->Global()
+          ->Get(context, String::NewFromUtf8(context->GetIsolate(), name)
+                             .ToLocalChecked())
+          .ToLocalChecked();
+  i::Handle<i::JSFunction> function =
+      i::Handle<i::JSFunction>::cast(Utils::OpenHandle(*value));
+  return function->shared().is_compiled();
+}
+
+}  // namespace
+
+TEST_F(ScriptTest, ConsumeCompileHints) {
+  const char* url = "http://www.foo.com/foo.js";
+  v8::ScriptOrigin origin(isolate(), NewString(url), 13, 0);
+
+  // The positions reported for this script by GetProducedCompileHints.
+  const char* code = "function lazy1() {} function lazy2() {}";
+  CompileHintsData data;
+  data.hints.push_back(14);
+  v8::ScriptCompiler::Source script_source(NewString(code), origin,
+                                           CompileHintCallback, &data);
+
+  Local<Script> script =
+      v8::ScriptCompiler::Compile(
+          v8_context(), &script_source,
+          v8::ScriptCompiler::CompileOptions::kConsumeCompileHints)
+          .ToLocalChecked();
+  EXPECT_EQ((std::vector<int>{14, 34}), data.queried_positions);
+
+  EXPECT_FALSE(script->Run(v8_context()).IsEmpty());
+  EXPECT_TRUE(IsFunctionCompiled(v8_context(), "lazy1"));
+  EXPECT_FALSE(IsFunctionCompiled(v8_context(), "lazy2"));
+}
+
 }  // namespace
 }  // namespace v8
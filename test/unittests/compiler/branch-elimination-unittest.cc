@@ -203,6 +203,71 @@ TEST_F(BranchEliminationTest, BranchInsideLoopSame) {
   EXPECT_THAT(ret1, IsReturn(IsInt32Constant(2), effect, loop));
 }
 
+TEST_F(BranchEliminationTest, DominatedMemoryBoundsCheck) {
+  // A bounds check for an access at a larger offset from the same index makes
+  // a subsequent bounds check at a smaller offset redundant, but not vice
+  // versa.
+  Node* index = Parameter(0);
+  Node* mem_size = Parameter(1);
+  auto BoundsCheck = [&](int32_t end_offset, Node* effect_and_control) {
+    Node* limit = graph()->NewNode(machine()->Int32Sub(), mem_size,
+                                   Int32Constant(end_offset));
+    Node* condition =
+        graph()->NewNode(machine()->Uint32LessThan(), index, limit);
+    return graph()->NewNode(common()->TrapUnless(TrapId::kTrapMemOutOfBounds),
+                            condition, effect_and_control, effect_and_control);
+  };
+  Node* check1 = BoundsCheck(7, graph()->start());
+  Node* check2 = BoundsCheck(3, check1);
+  Node* check3 = BoundsCheck(11, check2);
+
+  Node* zero = graph()->NewNode(common()->Int32Constant(0));
+  Node* ret = graph()->NewNode(common()->Return(), zero, index, check3, check3);
+  graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+
+  Reduce();
+
+  // {check2} is dominated by {check1} and should be removed; {check3} has to
+  // stay.
+  EXPECT_THAT(ret, IsReturn(index, check3, check3));
+  EXPECT_EQ(check1, NodeProperties::GetControlInput(check3));
+  EXPECT_EQ(check1, NodeProperties::GetEffectInput(check3));
+}
+
+TEST_F(BranchEliminationTest, DominatedMemoryBoundsCheckCanonicalized) {
+  // The MachineOperatorReducer turns {mem_size - end_offset} into
+  // {mem_size + -end_offset}, and {mem_size - 0} into {mem_size}.
+  Node* index = Parameter(0);
+  Node* mem_size = Parameter(1);
+  auto BoundsCheck = [&](Node* limit, Node* effect_and_control) {
+    Node* condition =
+        graph()->NewNode(machine()->Uint32LessThan(), index, limit);
+    return graph()->NewNode(common()->TrapUnless(TrapId::kTrapMemOutOfBounds),
+                            condition, effect_and_control, effect_and_control);
+  };
+  Node* check1 = BoundsCheck(
+      graph()->NewNode(machine()->Int32Add(), mem_size, Int32Constant(-7)),
+      graph()->start());
+  Node* check2 = BoundsCheck(
+      graph()->NewNode(machine()->Int32Sub(), mem_size, Int32Constant(3)),
+      check1);
+  Node* check3 = BoundsCheck(mem_size, check2);
+  Node* check4 = BoundsCheck(
+      graph()->NewNode(machine()->Int32Add(), mem_size, Int32Constant(-11)),
+      check3);
+
+  Node* zero = graph()->NewNode(common()->Int32Constant(0));
+  Node* ret = graph()->NewNode(common()->Return(), zero, index, check4, check4);
+  graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+
+  Reduce();
+
+  // {check2} and {check3} are dominated by {check1}; {check4} has to stay.
+  EXPECT_THAT(ret, IsReturn(index, check4, check4));
+  EXPECT_EQ(check1, NodeProperties::GetControlInput(check4));
+  EXPECT_EQ(check1, NodeProperties::GetEffectInput(check4));
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
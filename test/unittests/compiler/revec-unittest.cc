@@ -170,6 +170,70 @@ TEST_F(RevecTest, F32x8Mul) {
             MachineRepresentation::kSimd256);
 }
 
+// Create a graph which divides a F32x8 vector by the first element of vector b
+// and stores the result to a F32x8 vector c:
+//   float *a, *b, *c;
+//   c[0123] = a[0123] / b[0000];
+//   c[4567] = a[4567] / b[0000];
+//
+// The instruction selector doesn't support F32x8Div, so the graph must not be
+// revectorized.
+TEST_F(RevecTest, F32x4DivNotRevectorized) {
+  Node* start = graph()->NewNode(common()->Start(4));
+  graph()->SetStart(start);
+
+  Node* zero = graph()->NewNode(common()->Int32Constant(0));
+  Node* sixteen = graph()->NewNode(common()->Int64Constant(16));
+  Node* offset = graph()->NewNode(common()->Int64Constant(23));
+
+  // Wasm array base address
+  Node* p0 = graph()->NewNode(common()->Parameter(0), start);
+  // Load base address a*
+  Node* p1 = graph()->NewNode(common()->Parameter(1), start);
+  // LoadTransfrom base address b*
+  Node* p2 = graph()->NewNode(common()->Parameter(2), start);
+  // Store base address c*
+  Node* p3 = graph()->NewNode(common()->Parameter(3), start);
+
+  LoadRepresentation load_rep(MachineType::Simd128());
+  StoreRepresentation store_rep(MachineRepresentation::kSimd128,
+                                WriteBarrierKind::kNoWriteBarrier);
+  Node* base = graph()->NewNode(machine()->Load(MachineType::Int64()), p0,
+                                offset, start, start);
+  Node* base16 = graph()->NewNode(machine()->Int64Add(), base, sixteen);
+  Node* base16_store = graph()->NewNode(machine()->Int64Add(), base, sixteen);
+  Node* load0 = graph()->NewNode(machine()->ProtectedLoad(load_rep), base, p1,
+                                 base, start);
+  Node* load1 = graph()->NewNode(machine()->ProtectedLoad(load_rep), base16, p1,
+                                 load0, start);
+  Node* load2 = graph()->NewNode(
+      machine()->LoadTransform(MemoryAccessKind::kProtected,
+                               LoadTransformation::kS128Load32Splat),
+      base, p2, load1, start);
+  Node* div0 = graph()->NewNode(machine()->F32x4Div(), load0, load2);
+  Node* div1 = graph()->NewNode(machine()->F32x4Div(), load1, load2);
+  Node* store0 = graph()->NewNode(machine()->Store(store_rep), base, p3, div0,
+                                  load2, start);
+  Node* store1 = graph()->NewNode(machine()->Store(store_rep), base16_store, p3,
+                                  div1, store0, start);
+  Node* ret = graph()->NewNode(common()->Return(0), zero, store1, start);
+  Node* end = graph()->NewNode(common()->End(1), ret);
+  graph()->SetEnd(end);
+
+  graph()->RecordSimdStore(store0);
+  graph()->RecordSimdStore(store1);
+  graph()->SetSimd(true);
+
+  Revectorizer revec(zone(), graph(), mcgraph());
+  EXPECT_FALSE(revec.TryRevectorize(nullptr));
+
+  // Test whether the graph is unchanged
+  EXPECT_EQ(ret->InputAt(1), store1);
+  EXPECT_EQ(StoreRepresentationOf(store1->op()).representation(),
+            MachineRepresentation::kSimd128);
+  EXPECT_EQ(store1->InputAt(2), div1);
+}
+
 // Create a graph with load chain that can not be packed due to effect
 // dependency:
 //   [Load4] -> [Load3] -> [Load2] -> [Irrelevant Load] -> [Load1]
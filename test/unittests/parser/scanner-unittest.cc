@@ -7,6 +7,8 @@
 
 #include "src/parsing/scanner.h"
 
+#include <string>
+
 #include "src/handles/handles-inl.h"
 #include "src/objects/objects-inl.h"
 #include "src/parsing/parse-info.h"
@@ -110,5 +112,23 @@ TEST_F(ScannerTest, AllThePushbacks) {
   }
 }
 
+TEST_F(ScannerTest, LongRuns) {
+  // Whitespace, comments, strings and identifiers which span several blocks of
+  // the character stream, and are skipped in bulk.
+  std::string run(1000, 'a');
+  std::string src = std::string(1000, ' ') + "//" + run + "\n/*" + run + "\n" +
+                    run + "*/'" + run + "' " + run + "Z instanceof instanceofs";
+  auto scanner = make_scanner(src.c_str());
+  Zone zone(isolate()->allocator(), ZONE_NAME);
+
+  CHECK_TOK(Token::STRING, scanner->Next());
+  CHECK_EQ(run, std::string(scanner->CurrentLiteralAsCString(&zone)));
+  CHECK_TOK(Token::IDENTIFIER, scanner->Next());
+  CHECK_EQ(run + "Z", std::string(scanner->CurrentLiteralAsCString(&zone)));
+  CHECK_TOK(Token::INSTANCEOF, scanner->Next());
+  CHECK_TOK(Token::IDENTIFIER, scanner->Next());
+  CHECK_TOK(Token::EOS, scanner->Next());
+}
+
 }  // namespace internal
 }  // namespace v8